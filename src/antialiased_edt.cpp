@@ -0,0 +1,161 @@
+#include "antialiased_edt.h"
+#include <cmath>
+
+using namespace sdfgen;
+
+constexpr float antialiased_edt::far;
+
+antialiased_edt::antialiased_edt()
+{
+
+}
+
+antialiased_edt::~antialiased_edt()
+{
+
+}
+
+void antialiased_edt::transform(const float * coverage, const uint32_t width, const uint32_t height, const float limit, float * distances)
+{
+	const size_t count = (size_t) width * height;
+	if(count == 0) return;
+
+	compute_gradient(coverage, width, height);
+
+	// Every pixel starts out pointing at itself:
+	m_nearest_x.assign(count, 0);
+	m_nearest_y.assign(count, 0);
+	for(size_t i = 0; i < count; ++i) {
+		if(coverage[i] <= 0.0f) distances[i] = far;
+		else if(coverage[i] < 1.0f) distances[i] = edge_distance(m_gradient_x[i], m_gradient_y[i], coverage[i]);
+		else distances[i] = 0.0f;
+	}
+
+	// Offer the neighbor (x + nx, y + ny) to the pixel at (x, y), returning true if it was closer.
+	// Edges beyond the limit are never taken, which keeps the sweeps from crossing empty areas:
+	const float epsilon = 1e-3f;
+	const int64_t square_limit = (int64_t) std::ceil(limit) * (int64_t) std::ceil(limit);
+	auto propagate = [&](const uint32_t x, const uint32_t y, const int32_t nx, const int32_t ny) {
+		const int64_t sx = (int64_t) x + nx;
+		const int64_t sy = (int64_t) y + ny;
+		if(sx < 0 || sy < 0 || sx >= width || sy >= height) return false;
+
+		const size_t index = (size_t) y * width + x;
+		const size_t neighbor = (size_t) sy * width + (size_t) sx;
+		if(distances[neighbor] >= far) return false;
+
+		const int32_t dx = m_nearest_x[neighbor] - nx;
+		const int32_t dy = m_nearest_y[neighbor] - ny;
+		if(dx == m_nearest_x[index] && dy == m_nearest_y[index]) return false;
+
+		// The estimate within an edge pixel moves the distance by at most half a diagonal, so most
+		// candidates can be ruled out without a square root:
+		const int64_t square_distance = (int64_t) dx * dx + (int64_t) dy * dy;
+		if(square_distance > square_limit) return false;
+		const float bound = distances[index] - epsilon + 0.7072f;
+		if(bound > 0.0f && (float) square_distance >= bound * bound) return false;
+
+		const size_t edge_index = (size_t) ((int64_t) neighbor - m_nearest_x[neighbor] - (int64_t) m_nearest_y[neighbor] * width);
+		const float distance = distance_to_edge(coverage, edge_index, dx, dy);
+
+		if(distance < distances[index] - epsilon) {
+			m_nearest_x[index] = dx;
+			m_nearest_y[index] = dy;
+			distances[index] = distance;
+			return true;
+		}
+		return false;
+	};
+
+	// Sweep down and up until nothing changes, the edge estimates can make a later sweep find a closer edge:
+	bool changed;
+	do {
+		changed = false;
+
+		for(uint32_t y = 0; y < height; ++y) {
+			for(uint32_t x = 0; x < width; ++x) {
+				if(distances[(size_t) y * width + x] <= 0.0f) continue;
+				changed |= propagate(x, y, -1, 0);
+				changed |= propagate(x, y, -1, -1);
+				changed |= propagate(x, y, 0, -1);
+				changed |= propagate(x, y, 1, -1);
+			}
+			for(uint32_t x = width; x-- > 0; ) {
+				if(distances[(size_t) y * width + x] <= 0.0f) continue;
+				changed |= propagate(x, y, 1, 0);
+			}
+		}
+
+		for(uint32_t y = height; y-- > 0; ) {
+			for(uint32_t x = width; x-- > 0; ) {
+				if(distances[(size_t) y * width + x] <= 0.0f) continue;
+				changed |= propagate(x, y, 1, 0);
+				changed |= propagate(x, y, 1, 1);
+				changed |= propagate(x, y, 0, 1);
+				changed |= propagate(x, y, -1, 1);
+			}
+			for(uint32_t x = 0; x < width; ++x) {
+				if(distances[(size_t) y * width + x] <= 0.0f) continue;
+				changed |= propagate(x, y, -1, 0);
+			}
+		}
+	} while(changed);
+}
+
+void antialiased_edt::compute_gradient(const float * coverage, const uint32_t width, const uint32_t height)
+{
+	const float sqrt2 = 1.4142136f;
+	const size_t w = width;
+	m_gradient_x.assign(w * height, 0.0f);
+	m_gradient_y.assign(w * height, 0.0f);
+
+	for(uint32_t y = 1; y + 1 < height; ++y) {
+		for(uint32_t x = 1; x + 1 < width; ++x) {
+			const size_t k = (size_t) y * w + x;
+			if(coverage[k] <= 0.0f || coverage[k] >= 1.0f) continue;
+
+			float gx = -coverage[k - w - 1] - sqrt2 * coverage[k - 1] - coverage[k + w - 1] + coverage[k - w + 1] + sqrt2 * coverage[k + 1] + coverage[k + w + 1];
+			float gy = -coverage[k - w - 1] - sqrt2 * coverage[k - w] - coverage[k - w + 1] + coverage[k + w - 1] + sqrt2 * coverage[k + w] + coverage[k + w + 1];
+			const float length = std::sqrt(gx * gx + gy * gy);
+			if(length > 0.0f) {
+				gx /= length;
+				gy /= length;
+			}
+			m_gradient_x[k] = gx;
+			m_gradient_y[k] = gy;
+		}
+	}
+}
+
+float antialiased_edt::edge_distance(float gx, float gy, const float a)
+{
+	// Along an axis, or without any gradient at all, the linear estimate is exact or at least a fair guess:
+	if(gx == 0.0f || gy == 0.0f) return 0.5f - a;
+
+	const float length = std::sqrt(gx * gx + gy * gy);
+	gx = std::fabs(gx / length);
+	gy = std::fabs(gy / length);
+	if(gx < gy) {
+		const float swap = gx;
+		gx = gy;
+		gy = swap;
+	}
+
+	// The covered area is a triangle up to a1, a trapezoid up to 1 - a1 and a pentagon beyond:
+	const float a1 = 0.5f * gy / gx;
+	if(a < a1) return 0.5f * (gx + gy) - std::sqrt(2.0f * gx * gy * a);
+	if(a < 1.0f - a1) return (0.5f - a) * gx;
+	return -0.5f * (gx + gy) + std::sqrt(2.0f * gx * gy * (1.0f - a));
+}
+
+float antialiased_edt::distance_to_edge(const float * coverage, const size_t edge_index, const int32_t dx, const int32_t dy) const
+{
+	float a = coverage[edge_index];
+	if(a > 1.0f) a = 1.0f;
+	if(a <= 0.0f) return far;
+
+	// Next to the edge only the local gradient says where it lies, further away the direction to it does:
+	const float di = std::sqrt((float) dx * dx + (float) dy * dy);
+	if(di == 0.0f) return edge_distance(m_gradient_x[edge_index], m_gradient_y[edge_index], a);
+	return di + edge_distance((float) dx, (float) dy, a);
+}
\ No newline at end of file
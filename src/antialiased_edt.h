@@ -0,0 +1,60 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+namespace sdfgen {
+
+	/**
+	* Anti-aliased Euclidean distance transform (Gustavson and Strand, 2011, "edtaa3").
+	*
+	* <p> The input is a coverage value in {@code [0, 1]} per pixel instead of a two-color image. Pixels
+	* with partial coverage are edge pixels, and the position of the edge inside each of them is estimated
+	* from the coverage and the local gradient. Distances are then propagated as vectors to the closest
+	* edge pixel in repeated raster sweeps, so they keep sub-pixel accuracy even at low resolution.
+	*/
+	class antialiased_edt {
+	private:
+		std::vector<float> m_gradient_x;
+		std::vector<float> m_gradient_y;
+		std::vector<int32_t> m_nearest_x;
+		std::vector<int32_t> m_nearest_y;
+
+	public:
+		/** Returned for pixels with no covered pixel within the limit. */
+		static constexpr float far = 1000000.0f;
+
+		antialiased_edt();
+		~antialiased_edt();
+
+		/**
+		* Computes the distance in pixels from every pixel to the edge of the covered area.
+		* Fully covered pixels get zero, partially covered pixels get their estimated distance to the
+		* edge within the pixel, which may be slightly negative.
+		*
+		* @param coverage {@code width * height} values, 1 for fully covered pixels
+		* @param limit how far to propagate distances, pixels further than that from the edge get {@link #far}
+		* @param distances receives {@code width * height} distances
+		*/
+		void transform(const float * coverage, const uint32_t width, const uint32_t height, const float limit, float * distances);
+
+	private:
+		/**
+		* Estimates the normalized gradient of the coverage at every partially covered pixel using a Sobel-like
+		* kernel. Pixels on the image border and pixels with no or full coverage get a zero gradient.
+		*/
+		void compute_gradient(const float * coverage, const uint32_t width, const uint32_t height);
+
+		/**
+		* Returns the distance from the center of a pixel with coverage {@code a} to the edge crossing it,
+		* assuming the edge is a straight line with normal {@code (gx, gy)}.
+		*/
+		static float edge_distance(float gx, float gy, const float a);
+
+		/**
+		* Returns the distance from a pixel to the edge pixel at {@code edge_index}, which lies
+		* {@code (dx, dy)} pixels away from it.
+		*/
+		float distance_to_edge(const float * coverage, const size_t edge_index, const int32_t dx, const int32_t dy) const;
+	};
+
+}
\ No newline at end of file
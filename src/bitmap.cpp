@@ -0,0 +1,116 @@
+#include "bitmap.h"
+
+using namespace sdfgen;
+
+bitmap::bitmap() : m_width(0), m_height(0), m_stride(0)
+{
+
+}
+
+bitmap::bitmap(const uint32_t width, const uint32_t height)
+	: m_width(width), m_height(height), m_stride((width + word_bits - 1) / word_bits)
+{
+	m_words.resize((size_t) m_stride * m_height, 0);
+}
+
+bitmap::~bitmap()
+{
+
+}
+
+bitmap bitmap::region(const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height) const
+{
+	bitmap copy(width, height);
+	if(copy.empty()) return copy;
+
+	// Every word of the copy is put together from two neighboring words of the source:
+	const uint32_t first_word = x / word_bits;
+	const uint32_t shift = x % word_bits;
+	const uint32_t tail_bits = width % word_bits;
+	const uint64_t tail_mask = tail_bits ? (1ULL << tail_bits) - 1 : ~0ULL;
+
+	for(uint32_t row_index = 0; row_index < height; ++row_index) {
+		const uint64_t * source = row(y + row_index);
+		uint64_t * target = copy.row(row_index);
+		for(uint32_t i = 0; i < copy.m_stride; ++i) {
+			const uint32_t word = first_word + i;
+			const uint64_t high = (shift && word + 1 < m_stride) ? source[word + 1] << (word_bits - shift) : 0;
+			target[i] = (source[word] >> shift) | high;
+		}
+		target[copy.m_stride - 1] &= tail_mask;
+	}
+
+	return copy;
+}
+
+void bitmap::drop_rows(const uint32_t count)
+{
+	const uint32_t dropped = count < m_height ? count : m_height;
+	m_words.erase(m_words.begin(), m_words.begin() + (size_t) dropped * m_stride);
+	m_height -= dropped;
+}
+
+uint64_t * bitmap::append_row()
+{
+	m_words.resize(m_words.size() + m_stride, 0);
+	return row(m_height++);
+}
+
+int32_t bitmap::find_nearest_in_row(const uint32_t y, const uint32_t center_x, const uint32_t x_begin, const uint32_t x_end, const bool value) const
+{
+	// XOR-ing against the center's value leaves a set bit for every pixel of the other color:
+	const uint64_t flip = value ? ~0ULL : 0ULL;
+	const uint64_t * words = row(y);
+	const uint32_t center_word = center_x / word_bits;
+	const uint32_t center_bit = center_x % word_bits;
+	int32_t nearest = -1;
+
+	// Right of (and including) the center, the lowest set bit is the closest:
+	uint64_t word = (words[center_word] ^ flip) & (~0ULL << center_bit);
+	for(uint32_t i = center_word; ; ) {
+		if(word) {
+			const uint32_t x = i * word_bits + count_trailing_zeros(word);
+			if(x <= x_end) nearest = (int32_t) (x - center_x);
+			break;
+		}
+		if(++i > x_end / word_bits) break;
+		word = words[i] ^ flip;
+	}
+
+	// Left of the center, the highest set bit is the closest. Nothing further away than what
+	// was found on the right can win:
+	const uint32_t left_begin = (nearest > 0 && center_x - x_begin >= (uint32_t) nearest) ? center_x - nearest + 1 : x_begin;
+	if(nearest != 0 && center_x > left_begin) {
+		word = (words[center_word] ^ flip) & ((1ULL << center_bit) - 1);
+		for(uint32_t i = center_word; ; ) {
+			if(word) {
+				const uint32_t x = i * word_bits + (word_bits - 1) - count_leading_zeros(word);
+				if(x >= left_begin) nearest = (int32_t) (center_x - x);
+				break;
+			}
+			if(i-- <= left_begin / word_bits) break;
+			word = words[i] ^ flip;
+		}
+	}
+
+	return nearest;
+}
+
+uint32_t bitmap::count_in_row(const uint32_t y, const uint32_t x_begin, const uint32_t x_end) const
+{
+	if(x_begin >= x_end) return 0;
+
+	const uint64_t * words = row(y);
+	const uint32_t first_word = x_begin / word_bits;
+	const uint32_t last_word = (x_end - 1) / word_bits;
+	const uint64_t first_mask = ~0ULL << (x_begin % word_bits);
+	const uint64_t last_mask = ~0ULL >> (word_bits - 1 - (x_end - 1) % word_bits);
+
+	if(first_word == last_word) return count_ones(words[first_word] & first_mask & last_mask);
+
+	uint32_t count = count_ones(words[first_word] & first_mask) + count_ones(words[last_word] & last_mask);
+	for(uint32_t i = first_word + 1; i < last_word; ++i) {
+		count += count_ones(words[i]);
+	}
+	return count;
+}
\ No newline at end of file
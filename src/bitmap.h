@@ -0,0 +1,120 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#ifdef _MSC_VER
+#	include <intrin.h>
+#endif
+
+namespace sdfgen {
+
+	/**
+	* A two-color image packed at one bit per pixel, {@code true} representing "inside".
+	*
+	* <p> Every row starts on a new 64-bit word and pixel {@code x} of a row is bit {@code x % 64}
+	* of word {@code x / 64}, so a whole run of 64 pixels can be tested with a single word operation.
+	*/
+	class bitmap {
+	private:
+		std::vector<uint64_t> m_words;
+		uint32_t m_width;
+		uint32_t m_height;
+		uint32_t m_stride;
+
+	public:
+		static constexpr uint32_t word_bits = 64;
+
+		bitmap();
+		bitmap(const uint32_t width, const uint32_t height);
+		~bitmap();
+
+		const uint32_t& width() const { return m_width; }
+		const uint32_t& height() const { return m_height; }
+		/** The number of 64-bit words per row. */
+		const uint32_t& stride() const { return m_stride; }
+		bool empty() const { return m_words.empty(); }
+
+		/** Returns a copy of the rectangle from {@code (x, y)} of size {@code width} by {@code height}, which must lie within the bitmap. */
+		bitmap region(const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height) const;
+
+		/** Removes the first {@code count} rows, moving the rest up. */
+		void drop_rows(const uint32_t count);
+
+		/** Appends a row of "outside" pixels at the bottom and returns it. */
+		uint64_t * append_row();
+
+		const uint64_t * row(const uint32_t y) const { return m_words.data() + (size_t) y * m_stride; }
+		uint64_t * row(const uint32_t y) { return m_words.data() + (size_t) y * m_stride; }
+
+		bool get(const uint32_t x, const uint32_t y) const { return ((row(y)[x / word_bits] >> (x % word_bits)) & 1U) != 0; }
+		void set(const uint32_t x, const uint32_t y, const bool value)
+		{
+			const uint64_t mask = 1ULL << (x % word_bits);
+			if(value) row(y)[x / word_bits] |= mask;
+			else row(y)[x / word_bits] &= ~mask;
+		}
+
+		/**
+		* Finds the pixel closest to {@code center_x} in row {@code y} whose value differs from {@code value},
+		* looking only at pixels {@code x_begin} through {@code x_end} (inclusive).
+		*
+		* <p> Each side of the center is searched a word at a time, so this takes about
+		* {@code (x_end - x_begin) / 64} steps in the worst case.
+		*
+		* @return the horizontal distance to that pixel, or -1 if there is none
+		*/
+		int32_t find_nearest_in_row(const uint32_t y, const uint32_t center_x, const uint32_t x_begin, const uint32_t x_end, const bool value) const;
+
+		/** Returns the number of "inside" pixels in row {@code y} from {@code x_begin} inclusive to {@code x_end} exclusive. */
+		uint32_t count_in_row(const uint32_t y, const uint32_t x_begin, const uint32_t x_end) const;
+
+		/** Returns the number of set bits in a word. */
+		static inline uint32_t count_ones(uint64_t word)
+		{
+#if defined(_MSC_VER)
+			word = word - ((word >> 1) & 0x5555555555555555ULL);
+			word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+			word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+			return (uint32_t) ((word * 0x0101010101010101ULL) >> 56);
+#else
+			return (uint32_t) __builtin_popcountll(word);
+#endif
+		}
+
+		/** Returns the index of the lowest set bit of a non-zero word. */
+		static inline uint32_t count_trailing_zeros(const uint64_t word)
+		{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+			unsigned long index = 0;
+			_BitScanForward64(&index, word);
+			return (uint32_t) index;
+#elif defined(_MSC_VER)
+			unsigned long index = 0;
+			if(_BitScanForward(&index, (unsigned long) word)) return (uint32_t) index;
+			_BitScanForward(&index, (unsigned long) (word >> 32));
+			return (uint32_t) index + 32;
+#else
+			return (uint32_t) __builtin_ctzll(word);
+#endif
+		}
+
+		/** Returns the number of zero bits above the highest set bit of a non-zero word. */
+		static inline uint32_t count_leading_zeros(const uint64_t word)
+		{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+			unsigned long index = 0;
+			_BitScanReverse64(&index, word);
+			return 63 - (uint32_t) index;
+#elif defined(_MSC_VER)
+			unsigned long index = 0;
+			if(_BitScanReverse(&index, (unsigned long) (word >> 32))) return 31 - (uint32_t) index;
+			_BitScanReverse(&index, (unsigned long) word);
+			return 63 - (uint32_t) index;
+#else
+			return (uint32_t) __builtin_clzll(word);
+#endif
+		}
+	};
+
+	typedef std::shared_ptr<bitmap> bitmap_ptr;
+}
\ No newline at end of file
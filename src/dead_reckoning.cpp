@@ -0,0 +1,55 @@
+#include "dead_reckoning.h"
+#include <exception>
+
+using namespace sdfgen;
+
+void dead_reckoning::find_nearest(const bitmap& mask, std::vector<uint32_t>& nearest)
+{
+	const uint32_t width = mask.width();
+	const uint32_t height = mask.height();
+	if((uint64_t) width * height >= none) {
+		throw std::exception("Dead reckoning supports images of fewer than 4294967295 pixels");
+	}
+
+	nearest.assign((size_t) width * height, none);
+	if(nearest.empty()) return;
+
+	// Offer the neighbor at (nx, ny) to the pixel at (x, y). A neighbor of the opposite color is itself
+	// a candidate, a neighbor of the same color passes on the closest pixel it knows about:
+	auto propagate = [&](const uint32_t x, const uint32_t y, const bool inside, const uint32_t nx, const uint32_t ny) {
+		const uint32_t neighbor = ny * width + nx;
+		const uint32_t candidate = mask.get(nx, ny) != inside ? neighbor : nearest[neighbor];
+		if(candidate == none) return;
+
+		uint32_t& current = nearest[(size_t) y * width + x];
+		if(current == none || square_distance(x, y, candidate, width) < square_distance(x, y, current, width)) {
+			current = candidate;
+		}
+	};
+
+	// First pass, top to bottom and left to right, looking up and left:
+	for(uint32_t y = 0; y < height; ++y) {
+		for(uint32_t x = 0; x < width; ++x) {
+			const bool inside = mask.get(x, y);
+			if(y > 0) {
+				if(x > 0) propagate(x, y, inside, x - 1, y - 1);
+				propagate(x, y, inside, x, y - 1);
+				if(x + 1 < width) propagate(x, y, inside, x + 1, y - 1);
+			}
+			if(x > 0) propagate(x, y, inside, x - 1, y);
+		}
+	}
+
+	// Second pass, bottom to top and right to left, looking down and right:
+	for(uint32_t y = height; y-- > 0; ) {
+		for(uint32_t x = width; x-- > 0; ) {
+			const bool inside = mask.get(x, y);
+			if(x + 1 < width) propagate(x, y, inside, x + 1, y);
+			if(y + 1 < height) {
+				if(x > 0) propagate(x, y, inside, x - 1, y + 1);
+				propagate(x, y, inside, x, y + 1);
+				if(x + 1 < width) propagate(x, y, inside, x + 1, y + 1);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "bitmap.h"
+
+namespace sdfgen {
+
+	/**
+	* Dead reckoning distance transform (Grevera, 2004). Two raster sweeps over the image, each looking at
+	* four of the eight neighbors, propagate the position of the closest pixel of the opposite color.
+	*
+	* <p> Carrying the actual position instead of an accumulated distance keeps the result very close to
+	* the exact Euclidean distance, at a fixed cost of two passes no matter how far distances reach.
+	*/
+	class dead_reckoning {
+	public:
+		/** Marks a pixel with no pixel of the opposite color found. */
+		static constexpr uint32_t none = 0xFFFFFFFF;
+
+		/**
+		* For every pixel of {@code mask}, finds the (approximately) closest pixel of the opposite color.
+		*
+		* @param nearest receives {@code width * height} pixel indices ({@code y * width + x}),
+		* or {@link #none} if the image has only one color
+		* @throws std::exception if the mask has {@link #none} pixels or more, whose indices would not fit
+		*/
+		static void find_nearest(const bitmap& mask, std::vector<uint32_t>& nearest);
+
+		/** Returns the squared distance between a pixel and the pixel at {@code index}. */
+		static inline int64_t square_distance(const uint32_t x, const uint32_t y, const uint32_t index, const uint32_t width)
+		{
+			const int64_t dx = (int64_t) x - (int64_t) (index % width);
+			const int64_t dy = (int64_t) y - (int64_t) (index / width);
+			return dx * dx + dy * dy;
+		}
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "distance_transform.h"
+#include <algorithm>
+
+#undef min
+#undef max
+
+using namespace sdfgen;
+
+distance_transform::distance_transform()
+{
+
+}
+
+distance_transform::~distance_transform()
+{
+
+}
+
+void distance_transform::column_pass(
+	const bitmap& mask,
+	const int32_t column_begin, const int32_t column_end,
+	const int32_t first_row, const int32_t row_step, const int32_t row_count,
+	const int32_t limit, int32_t * to_outside, int32_t * to_inside)
+{
+	if(row_count <= 0 || column_end <= column_begin) return;
+
+	const int32_t width = (int32_t) mask.width();
+	const int32_t height = (int32_t) mask.height();
+	const int32_t columns = column_end - column_begin;
+
+	// Sweep downwards keeping the distance to the closest pixel above (or at) each row, then sweep
+	// upwards with the closest pixel below. Only the sampled rows are ever stored:
+	std::vector<int32_t> outside_run(columns, limit);
+	std::vector<int32_t> inside_run(columns, limit);
+
+	for(int32_t y = 0, row = 0; y < height && row < row_count; ++y) {
+		const uint64_t * mask_row = mask.row((uint32_t) y);
+		for(int32_t x = 0; x < columns; ++x) {
+			const uint32_t column = (uint32_t) (column_begin + x);
+			if((mask_row[column / bitmap::word_bits] >> (column % bitmap::word_bits)) & 1U) {
+				outside_run[x] = std::min<int32_t>(outside_run[x] + 1, limit);
+				inside_run[x] = 0;
+			}
+			else {
+				outside_run[x] = 0;
+				inside_run[x] = std::min<int32_t>(inside_run[x] + 1, limit);
+			}
+		}
+
+		if(y == first_row + row * row_step) {
+			std::copy(outside_run.begin(), outside_run.end(), to_outside + (size_t) row * width + column_begin);
+			std::copy(inside_run.begin(), inside_run.end(), to_inside + (size_t) row * width + column_begin);
+			++row;
+		}
+	}
+
+	std::fill(outside_run.begin(), outside_run.end(), limit);
+	std::fill(inside_run.begin(), inside_run.end(), limit);
+
+	for(int32_t y = height - 1, row = row_count - 1; y >= first_row && row >= 0; --y) {
+		const uint64_t * mask_row = mask.row((uint32_t) y);
+		for(int32_t x = 0; x < columns; ++x) {
+			const uint32_t column = (uint32_t) (column_begin + x);
+			if((mask_row[column / bitmap::word_bits] >> (column % bitmap::word_bits)) & 1U) {
+				outside_run[x] = std::min<int32_t>(outside_run[x] + 1, limit);
+				inside_run[x] = 0;
+			}
+			else {
+				outside_run[x] = 0;
+				inside_run[x] = std::min<int32_t>(inside_run[x] + 1, limit);
+			}
+		}
+
+		if(y == first_row + row * row_step) {
+			int32_t * outside_row = to_outside + (size_t) row * width + column_begin;
+			int32_t * inside_row = to_inside + (size_t) row * width + column_begin;
+			for(int32_t x = 0; x < columns; ++x) {
+				outside_row[x] = std::min<int32_t>(outside_row[x], outside_run[x]);
+				inside_row[x] = std::min<int32_t>(inside_row[x], inside_run[x]);
+			}
+			--row;
+		}
+	}
+}
+
+void distance_transform::row_pass(const int32_t * column_distances, const int32_t length, const int32_t limit, int32_t * squared_distances)
+{
+	if(length <= 0) return;
+
+	const int64_t squared_limit = (int64_t) limit * limit;
+	const int32_t * g = column_distances;
+
+	// f(x, i) is the squared distance from x to the closest feature in column i:
+	auto f = [g](const int64_t x, const int32_t i) -> int64_t {
+		return (x - i) * (x - i) + (int64_t) g[i] * g[i];
+	};
+
+	// sep(i, u) is the first column at which the parabola of u lies below the one of i:
+	auto sep = [g](const int32_t i, const int32_t u) -> int64_t {
+		return ((int64_t) u * u - (int64_t) i * i + (int64_t) g[u] * g[u] - (int64_t) g[i] * g[i]) / (2 * (int64_t) (u - i));
+	};
+
+	m_sites.resize(length);
+	m_starts.resize(length);
+
+	// Build the lower envelope of the parabolas:
+	int32_t q = 0;
+	m_sites[0] = 0;
+	m_starts[0] = 0;
+	for(int32_t u = 1; u < length; ++u) {
+		while(q >= 0 && f(m_starts[q], m_sites[q]) > f(m_starts[q], u)) {
+			--q;
+		}
+
+		if(q < 0) {
+			q = 0;
+			m_sites[0] = u;
+		}
+		else {
+			const int64_t start = 1 + sep(m_sites[q], u);
+			if(start < length) {
+				++q;
+				m_sites[q] = u;
+				m_starts[q] = (int32_t) start;
+			}
+		}
+	}
+
+	// Walk the envelope backwards to evaluate it at every pixel of the row:
+	for(int32_t u = length - 1; u >= 0; --u) {
+		squared_distances[u] = (int32_t) std::min<int64_t>(f(u, m_sites[q]), squared_limit);
+		if(u == m_starts[q]) --q;
+	}
+}
\ No newline at end of file
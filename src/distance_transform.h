@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "bitmap.h"
+
+namespace sdfgen {
+
+	/**
+	* Exact squared Euclidean distance transform, separable into a column pass and a row pass
+	* as described by Meijster, Roerdink and Hesselink (2000). Both passes run in linear time,
+	* so the cost does not depend on how far the distances reach.
+	*
+	* All distances are clamped to a {@code limit}, which lets the generator discard anything
+	* beyond its spread without ever overflowing.
+	*/
+	class distance_transform {
+	private:
+		std::vector<int32_t> m_sites;
+		std::vector<int32_t> m_starts;
+
+	public:
+		distance_transform();
+		~distance_transform();
+
+		/**
+		* First (column) pass. For every sampled row, computes the vertical distance from each pixel
+		* to the closest "outside" and the closest "inside" pixel in the same column.
+		*
+		* Rows are sampled starting at {@code first_row}, every {@code row_step} rows, {@code row_count} times.
+		* Both outputs are {@code row_count * mask.width()} values, clamped to {@code limit}. Only the columns in
+		* {@code [column_begin, column_end)} are written, so disjoint column ranges can run in parallel.
+		*
+		* @param mask the two-color image, {@code true} representing "inside"
+		* @param to_outside receives the column distance to the closest "outside" pixel
+		* @param to_inside receives the column distance to the closest "inside" pixel
+		*/
+		static void column_pass(
+			const bitmap& mask,
+			const int32_t column_begin, const int32_t column_end,
+			const int32_t first_row, const int32_t row_step, const int32_t row_count,
+			const int32_t limit, int32_t * to_outside, int32_t * to_inside
+		);
+
+		/**
+		* Second (row) pass. Given the column distances of one row, computes the squared distance
+		* from each pixel in the row to the closest feature pixel.
+		*
+		* @param column_distances the column distances of a row, as produced by {@link #column_pass}
+		* @param length the number of pixels in the row
+		* @param limit squared distances are clamped to {@code limit * limit}
+		* @param squared_distances receives {@code length} squared distances
+		*/
+		void row_pass(const int32_t * column_distances, const int32_t length, const int32_t limit, int32_t * squared_distances);
+	};
+
+}
\ No newline at end of file
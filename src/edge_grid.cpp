@@ -0,0 +1,93 @@
+#include "edge_grid.h"
+#include <algorithm>
+
+#undef min
+#undef max
+
+using namespace sdfgen;
+
+edge_grid::edge_grid() : m_cell_size(1), m_columns(0), m_rows(0)
+{
+
+}
+
+edge_grid::~edge_grid()
+{
+
+}
+
+void edge_grid::build(const bitmap& mask, const bool inside, const uint32_t cell_size)
+{
+	const uint32_t width = mask.width();
+	const uint32_t height = mask.height();
+	const uint32_t stride = mask.stride();
+	const uint32_t tail_bits = width % bitmap::word_bits;
+	const uint64_t tail_mask = tail_bits ? (1ULL << tail_bits) - 1 : ~0ULL;
+
+	m_cell_size = std::max<uint32_t>(1, cell_size);
+	m_columns = (width + m_cell_size - 1) / m_cell_size;
+	m_rows = (height + m_cell_size - 1) / m_cell_size;
+	m_points.clear();
+
+	// Compare every word with its four shifted neighbors at once. Pixels on the image border are
+	// compared with themselves on the missing side, so the border never counts as an edge:
+	for(uint32_t y = 0; y < height; ++y) {
+		const uint64_t * row = mask.row(y);
+		const uint64_t * up = mask.row(y > 0 ? y - 1 : y);
+		const uint64_t * down = mask.row(y + 1 < height ? y + 1 : y);
+
+		for(uint32_t i = 0; i < stride; ++i) {
+			const uint64_t word = row[i];
+			const uint64_t valid = (i + 1 == stride) ? tail_mask : ~0ULL;
+			const uint64_t last_bit = (i + 1 == stride && tail_bits) ? tail_bits - 1 : bitmap::word_bits - 1;
+			const uint64_t left = (word << 1) | (i > 0 ? row[i - 1] >> 63 : word & 1ULL);
+			const uint64_t right = (word >> 1) | (i + 1 < stride ? row[i + 1] << 63 : ((word >> last_bit) & 1ULL) << last_bit);
+			const uint64_t edges = ((word ^ left) | (word ^ right) | (word ^ up[i]) | (word ^ down[i])) & (inside ? word : ~word) & valid;
+
+			for(uint64_t bits = edges; bits; bits &= bits - 1) {
+				m_points.push_back({ i * bitmap::word_bits + bitmap::count_trailing_zeros(bits), y });
+			}
+		}
+	}
+
+	// Counting sort into the cells:
+	m_cell_starts.assign((size_t) m_columns * m_rows + 1, 0);
+	for(const point& p : m_points) {
+		++m_cell_starts[(size_t) (p.y / m_cell_size) * m_columns + p.x / m_cell_size + 1];
+	}
+	for(size_t i = 1; i < m_cell_starts.size(); ++i) {
+		m_cell_starts[i] += m_cell_starts[i - 1];
+	}
+
+	std::vector<point> sorted(m_points.size());
+	std::vector<uint32_t> next(m_cell_starts.begin(), m_cell_starts.end() - 1);
+	for(const point& p : m_points) {
+		sorted[next[(size_t) (p.y / m_cell_size) * m_columns + p.x / m_cell_size]++] = p;
+	}
+	m_points.swap(sorted);
+}
+
+int64_t edge_grid::closest_square_distance(const uint32_t x, const uint32_t y, const uint32_t radius) const
+{
+	const int64_t limit = (int64_t) radius * radius;
+	if(m_points.empty() || radius == 0) return limit;
+
+	const uint32_t reach = radius - 1;
+	const uint32_t first_column = (x > reach ? x - reach : 0) / m_cell_size;
+	const uint32_t last_column = std::min<uint32_t>(m_columns - 1, (x + reach) / m_cell_size);
+	const uint32_t first_row = (y > reach ? y - reach : 0) / m_cell_size;
+	const uint32_t last_row = std::min<uint32_t>(m_rows - 1, (y + reach) / m_cell_size);
+	int64_t closest = limit;
+
+	for(uint32_t row = first_row; row <= last_row; ++row) {
+		const size_t cell = (size_t) row * m_columns;
+		for(uint32_t i = m_cell_starts[cell + first_column]; i < m_cell_starts[cell + last_column + 1]; ++i) {
+			const int64_t dx = (int64_t) m_points[i].x - x;
+			const int64_t dy = (int64_t) m_points[i].y - y;
+			const int64_t square_distance = dx * dx + dy * dy;
+			if(square_distance < closest) closest = square_distance;
+		}
+	}
+
+	return closest;
+}
\ No newline at end of file
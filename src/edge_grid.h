@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "bitmap.h"
+
+namespace sdfgen {
+
+	/**
+	* The edge pixels of one color of a bitmap, bucketed into a uniform grid of square cells.
+	*
+	* <p> An edge pixel is a pixel with at least one 4-neighbor of the other color. The closest pixel of
+	* the other color is always such an edge pixel, so the exact distance can be found by looking only
+	* at the edge pixels in the cells around a point, and those are usually a tiny part of an image.
+	*/
+	class edge_grid {
+	public:
+		struct point {
+			uint32_t x;
+			uint32_t y;
+		};
+
+	private:
+		uint32_t m_cell_size;
+		uint32_t m_columns;
+		uint32_t m_rows;
+		std::vector<uint32_t> m_cell_starts;
+		std::vector<point> m_points;
+
+	public:
+		edge_grid();
+		~edge_grid();
+
+		/**
+		* Extracts the edge pixels of {@code mask} that have the color {@code inside} and buckets them.
+		*
+		* @param cell_size the width and height of a grid cell in pixels, usually the search radius
+		*/
+		void build(const bitmap& mask, const bool inside, const uint32_t cell_size);
+
+		/** Returns the number of edge pixels in the grid. */
+		size_t size() const { return m_points.size(); }
+
+		/**
+		* Returns the squared distance from {@code (x, y)} to the closest edge pixel, looking only at edge
+		* pixels closer than {@code radius}. Returns {@code radius * radius} if there is none.
+		* The radius must not be larger than the cell size.
+		*/
+		int64_t closest_square_distance(const uint32_t x, const uint32_t y, const uint32_t radius) const;
+	};
+
+}
\ No newline at end of file
@@ -8,16 +8,17 @@
 #include "image.h"
 #include <algorithm>
 #include <iterator>
+#include <fstream>
 
 using namespace sdfgen;
 
-image::image() : m_width(0), m_height(0)
+image::image() : m_width(0), m_height(0), m_format(pixel_format::rgba8)
 {
 
 }
 
 image::image(const byte_ptr pixels, const uint32_t width, const uint32_t height, const uint32_t bits)
-	: m_width(width), m_height(height)
+	: m_width(width), m_height(height), m_format(pixel_format::rgba8)
 {
 	if(bits != 24 && bits != 32) {
 		throw std::exception("Image can only be 24 or 32 bits per pixel");
@@ -33,15 +34,15 @@ image::image(const byte_ptr pixels, const uint32_t width, const uint32_t height,
 	}
 }
 
-image::image(const uint32_t width, const uint32_t height)
-	: m_width(width), m_height(height)
+image::image(const uint32_t width, const uint32_t height, const pixel_format format)
+	: m_width(width), m_height(height), m_format(format)
 {
-	const size_t length = this->width() * channels() * this->height();
+	const size_t length = (size_t) this->width() * bytes_per_pixel() * this->height();
 	m_buffer.resize(length);
 	clear(0);
 }
 
-image::image(const std::string& file)
+image::image(const std::string& file) : m_format(pixel_format::rgba8)
 {
 	load(file);
 }
@@ -70,7 +71,7 @@ void image::convert24to32(const byte_ptr in_pixels, byte_ptr out_pixels, const u
 void image::flip(const uint32_t type)
 {
 	if(!empty()) {
-		const uint32_t stride = width() * channels();
+		const uint32_t stride = width() * bytes_per_pixel();
 		byte_ptr row = new byte[stride];
 		byte_ptr buffer = &m_buffer[0];
 		byte_ptr low = buffer;
@@ -83,13 +84,8 @@ void image::flip(const uint32_t type)
 				std::memcpy(high, row, stride);
 			}
 			if(type & flip_type::horizontal) {
-				std::memcpy(row, low, stride);
-				std::reverse((uint32_t *) row, (uint32_t *) row + width());
-				std::memcpy(low, row, stride);
-
-				std::memcpy(row, high, stride);
-				std::reverse((uint32_t *) row, (uint32_t *) row + width());
-				std::memcpy(high, row, stride);
+				reverse_row(low);
+				reverse_row(high);
 			}
 		}
 
@@ -97,15 +93,28 @@ void image::flip(const uint32_t type)
 	}
 }
 
+void image::reverse_row(byte_ptr row)
+{
+	if(bytes_per_pixel() == 1) std::reverse(row, row + width());
+	else if(bytes_per_pixel() == 2) std::reverse((uint16_t *) row, (uint16_t *) row + width());
+	else std::reverse((uint32_t *) row, (uint32_t *) row + width());
+}
+
 void image::clear(const uint32_t color)
 {
 	if(!empty()) {
-		std::fill_n((uint32_t *) this->pixels(), width() * height(), color);
+		if(m_format == pixel_format::rgba8) std::fill_n((uint32_t *) this->pixels(), width() * height(), color);
+		else if(m_format == pixel_format::r8) std::fill(m_buffer.begin(), m_buffer.end(), (byte) (color >> 24));
+		else std::fill(m_buffer.begin(), m_buffer.end(), (byte) 0);
 	}
 }
 
 void image::resize(const uint32_t new_width, const uint32_t new_height)
 {
+	if(m_format != pixel_format::rgba8 && m_format != pixel_format::r8) {
+		throw std::exception("Only rgba8 and r8 images can be resized");
+	}
+
 	byte_ptr old_pixels = this->pixels();
 	byte_ptr new_pixels = new byte[new_width * channels() * new_height];
 	stbir_resize_uint8(old_pixels, width(), height(), width() * channels(), new_pixels, new_width, new_height, new_width * channels(), channels());
@@ -133,6 +142,7 @@ void image::load(const std::string& file)
 
 	this->m_width = (uint32_t) width;
 	this->m_height = (uint32_t) height;
+	this->m_format = pixel_format::rgba8;
 
 	if(buffer) stbi_image_free(buffer);
 }
@@ -141,6 +151,10 @@ void image::save(const std::string& file, const file_format format) const
 {
 	int result = 0;
 	if(!empty()) {
+		if(m_format != pixel_format::rgba8 && m_format != pixel_format::r8 && format != file_format::raw) {
+			throw std::exception("Floating point images can only be saved as raw");
+		}
+
 		switch(format) {
 		case file_format::bmp:
 			result = stbi_write_bmp(file.c_str(), (int) width(), (int) height(), (int) channels(), (const stbi_uc *) m_buffer.data());
@@ -151,6 +165,13 @@ void image::save(const std::string& file, const file_format format) const
 		case file_format::tga:
 			result = stbi_write_tga(file.c_str(), (int) width(), (int) height(), (int) channels(), (const stbi_uc *) m_buffer.data());
 			break;
+		case file_format::raw:
+		{
+			std::ofstream stream(file, std::ios::binary);
+			stream.write((const char *) m_buffer.data(), (std::streamsize) m_buffer.size());
+			result = stream.good() ? 1 : 0;
+			break;
+		}
 		}
 
 		if(!result) {
@@ -7,29 +7,44 @@
 namespace sdfgen {
 
 	class image {
+	public:
+		/**
+		* How the pixels are stored. {@code rgba8} is four 8-bit channels, the only format that can be loaded.
+		* {@code r8} is a single 8-bit channel, which can also be resized and saved as a grayscale PNG, BMP
+		* or TGA. {@code r32f} and {@code r16f} are a single 32-bit or 16-bit floating point channel, used to
+		* store distances as they are.
+		*/
+		enum class pixel_format { rgba8, r32f, r16f, r8 };
+
 	private:
 		std::vector<byte> m_buffer;
 		uint32_t m_width;
 		uint32_t m_height;
+		pixel_format m_format;
 
 		image();
 
 		static void convert24to32(const byte_ptr in_pixels, byte_ptr out_pixels, const uint32_t num_pixels);
+		void reverse_row(byte_ptr row);
 
 	public:
-		enum class file_format { png, bmp, tga };
+		/** {@code raw} writes the pixels as they are in memory, row by row, in any pixel format. */
+		enum class file_format { png, bmp, tga, raw };
 		enum flip_type : uint32_t { vertical = 1 << 0, horizontal = 1 << 1, };
 
 		image(const byte_ptr pixels, const uint32_t width, const uint32_t height, const uint32_t bits = 32);
-		image(const uint32_t width, const uint32_t height);
+		image(const uint32_t width, const uint32_t height, const pixel_format format = pixel_format::rgba8);
 		image(const std::string& file);
 		virtual ~image();
 
 		const byte_ptr pixels() const { return (const byte_ptr) m_buffer.data(); }
 		const uint32_t& width() const { return m_width; }
 		const uint32_t& height() const { return m_height; }
-		const uint32_t bits() const { return 32U; }
-		const uint32_t channels() const { return bits() / 8U; }
+		const pixel_format& format() const { return m_format; }
+		const uint32_t bits() const { return bytes_per_pixel() * 8U; }
+		const uint32_t channels() const { return m_format == pixel_format::rgba8 ? 4U : 1U; }
+		const uint32_t bytes_per_pixel() const { return bytes_per_pixel(m_format); }
+		static uint32_t bytes_per_pixel(const pixel_format format) { return format == pixel_format::r8 ? 1U : format == pixel_format::r16f ? 2U : 4U; }
 		uint32_t length() const { return static_cast<uint32_t>(m_buffer.size()); }
 		bool empty() const { return m_buffer.empty(); }
 		void reset() { m_buffer.clear(); m_width = 0; m_height = 0; }
@@ -42,7 +57,7 @@ namespace sdfgen {
 
 		// Supporting these formats: JPEG, PNG, BMP, PSD, TGA, GIF, HDR, PIC, PPM, and PGM
 		void load(const std::string& file);
-		// Supporting these formats: PNG, BMP, TGA
+		// Supporting these formats: PNG, BMP, TGA for rgba8 and r8, RAW for any pixel format
 		void save(const std::string& file, const file_format format = file_format::png) const;
 
 	};
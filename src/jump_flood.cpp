@@ -0,0 +1,67 @@
+#include "jump_flood.h"
+#include <exception>
+
+using namespace sdfgen;
+
+constexpr jump_flood::seed jump_flood::none;
+
+void jump_flood::find_nearest(const bitmap& mask, const uint32_t max_distance, thread_pool& pool, std::vector<seed>& seeds)
+{
+	const uint32_t width = mask.width();
+	const uint32_t height = mask.height();
+	if(width > max_size || height > max_size) {
+		throw std::exception("Jump flooding supports images up to 65535 pixels wide and high");
+	}
+
+	seeds.assign((size_t) width * height, none);
+	if(seeds.empty()) return;
+
+	// Steps of k reach up to 2k - 1 pixels, so start at the power of two just below the distance:
+	uint32_t first_step = 1;
+	while(first_step * 2 < max_distance) first_step *= 2;
+
+	std::vector<uint32_t> steps;
+	for(uint32_t step = first_step; step >= 1; step /= 2) steps.push_back(step);
+	steps.push_back(1);
+
+	std::vector<seed> next(seeds.size());
+
+	for(const uint32_t step : steps) {
+		pool.parallel_for(0, height, [&](const uint32_t begin, const uint32_t end) {
+			for(uint32_t y = begin; y < end; ++y) {
+				for(uint32_t x = 0; x < width; ++x) {
+					const bool inside = mask.get(x, y);
+					seed best = seeds[(size_t) y * width + x];
+					int64_t best_distance = is_none(best) ? -1 : square_distance(x, y, best);
+
+					for(int32_t dy = -1; dy <= 1; ++dy) {
+						const int64_t sy = (int64_t) y + dy * (int64_t) step;
+						if(sy < 0 || sy >= height) continue;
+						for(int32_t dx = -1; dx <= 1; ++dx) {
+							const int64_t sx = (int64_t) x + dx * (int64_t) step;
+							if(sx < 0 || sx >= width || (dx == 0 && dy == 0)) continue;
+
+							// A sample of the opposite color is a candidate itself, one of the same color
+							// passes on the closest pixel it has found so far:
+							seed candidate = { (uint16_t) sx, (uint16_t) sy };
+							if(mask.get((uint32_t) sx, (uint32_t) sy) == inside) {
+								candidate = seeds[(size_t) sy * width + sx];
+								if(is_none(candidate)) continue;
+							}
+
+							const int64_t distance = square_distance(x, y, candidate);
+							if(best_distance < 0 || distance < best_distance) {
+								best = candidate;
+								best_distance = distance;
+							}
+						}
+					}
+
+					next[(size_t) y * width + x] = best;
+				}
+			}
+		});
+
+		seeds.swap(next);
+	}
+}
\ No newline at end of file
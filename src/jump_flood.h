@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "bitmap.h"
+#include "thread_pool.h"
+
+namespace sdfgen {
+
+	/**
+	* Jump flooding (Rong and Tan, 2006). Every pixel repeatedly looks at eight samples {@code step} pixels
+	* away and adopts the closest pixel of the opposite color any of them knows about, with {@code step}
+	* halving from about half the maximum distance down to one, followed by one more pass at one pixel.
+	*
+	* <p> This takes {@code log2(max_distance) + 1} passes of independent per-pixel work, so every pass
+	* splits across threads without any synchronization. The result is approximate, though the error
+	* is small and bounded in practice.
+	*/
+	class jump_flood {
+	public:
+		/** A pixel position, or {@link #none}. Kept at 16 bits per coordinate to halve memory traffic. */
+		struct seed {
+			uint16_t x;
+			uint16_t y;
+		};
+
+		/** The largest width or height supported. */
+		static constexpr uint32_t max_size = 0xFFFF;
+		static constexpr seed none = { 0xFFFF, 0xFFFF };
+
+		/**
+		* For every pixel of {@code mask}, finds the (approximately) closest pixel of the opposite color
+		* within {@code max_distance}.
+		*
+		* @param seeds receives {@code width * height} positions, {@link #none} where nothing was found
+		* @throws std::exception if the mask is larger than {@link #max_size} in either direction
+		*/
+		static void find_nearest(const bitmap& mask, const uint32_t max_distance, thread_pool& pool, std::vector<seed>& seeds);
+
+		static inline bool is_none(const seed s) { return s.x == none.x && s.y == none.y; }
+
+		/** Returns the squared distance between a pixel and a seed. */
+		static inline int64_t square_distance(const uint32_t x, const uint32_t y, const seed s)
+		{
+			const int64_t dx = (int64_t) x - s.x;
+			const int64_t dy = (int64_t) y - s.y;
+			return dx * dx + dy * dy;
+		}
+	};
+
+}
\ No newline at end of file
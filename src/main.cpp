@@ -4,7 +4,11 @@
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <sstream>
+#include <vector>
 #include <chrono>
+#include <algorithm>
+#include <cstdlib>
 #include <stdint.h>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -12,19 +16,60 @@
 #include "sdf_generator.h"
 #include "preview_window.h"
 
+#undef min
+#undef max
+
 namespace sdfgen {
 
 	struct args_t {
 		bool verbose = true;
 		bool preview = false;
+		bool measure_error = false; // compares approximate algorithms against a second, exact run
 		std::string input_file;
 		std::string output_sdf_file;
 		std::string output_render_file;
 		float spread = 32.0f; // 32 for best results
 		int downscale = 4; // 4 for best results
+		uint32_t threads = 0; // 0 for one per hardware thread
+		sdfgen::sdf_generator::algorithm algorithm = sdfgen::sdf_generator::default_algorithm;
+		sdfgen::image::pixel_format format = sdfgen::image::pixel_format::rgba8; // r8 is saved as grayscale, float formats as raw
+		std::string variant_list; // as given, parsed into variants once the default downscale is known
+		std::vector<sdfgen::sdf_generator::variant> variants; // empty for a single field at spread and downscale
+		bool benchmark = false; // times generation row by row and in cache blocks instead of saving anything
 	} args;
 
 	using clock = std::chrono::high_resolution_clock;
+
+	/** Parses a list of variants such as "32:4,16:2,8:1", where a missing downscale means {@code default_downscale}. */
+	bool parse_variants(const std::string& list, const int32_t default_downscale, std::vector<sdf_generator::variant>& variants)
+	{
+		size_t begin = 0;
+		while(begin <= list.size()) {
+			size_t end = list.find(',', begin);
+			if(end == std::string::npos) end = list.size();
+			const std::string item = list.substr(begin, end - begin);
+			const size_t colon = item.find(':');
+			const sdf_generator::variant v = {
+				(float) atof(item.substr(0, colon).c_str()),
+				colon == std::string::npos ? default_downscale : atoi(item.substr(colon + 1).c_str())
+			};
+			if(!(v.spread > 0) || v.downscale < 1) return false;
+			variants.push_back(v);
+			begin = end + 1;
+		}
+		return !variants.empty();
+	}
+
+	/** Inserts the spread and downscale of a variant before the extension, "out.png" becoming "out_32_4.png". */
+	std::string variant_file(const std::string& file, const sdf_generator::variant& v)
+	{
+		std::ostringstream suffix;
+		suffix << "_" << v.spread << "_" << v.downscale;
+		const size_t dot = file.find_last_of('.');
+		const size_t slash = file.find_last_of("/\\");
+		if(dot == std::string::npos || (slash != std::string::npos && dot < slash)) return file + suffix.str();
+		return file.substr(0, dot) + suffix.str() + file.substr(dot);
+	}
 }
 
 int main(int argc, char *argv[])
@@ -40,6 +85,9 @@ int main(int argc, char *argv[])
 				else if(strcmp(argv[i], "-p") == 0 || strcmp(argv[i], "--preview") == 0) {
 					sdfgen::args.preview = true;
 				}
+				else if(strcmp(argv[i], "--measure-error") == 0) {
+					sdfgen::args.measure_error = true;
+				}
 				else if(strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--outrender") == 0) {
 					if(argc > i + 1) {
 						sdfgen::args.output_render_file = argv[++i];
@@ -60,11 +108,51 @@ int main(int argc, char *argv[])
 						sdfgen::args.downscale = atoi(argv[++i]);
 					}
 				}
+				else if(strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--threads") == 0) {
+					if(argc > i + 1) {
+						sdfgen::args.threads = (uint32_t) atoi(argv[++i]);
+					}
+				}
+				else if(strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--algorithm") == 0) {
+					if(argc > i + 1) {
+						if(!sdfgen::sdf_generator::parse_algorithm(argv[++i], sdfgen::args.algorithm)) {
+							std::cout << "Unknown algorithm \"" << argv[i] << "\" (expected brute_force, edt, spiral, dead_reckoning, jump_flood, edge_grid, coverage or grayscale)" << std::endl;
+							return -1;
+						}
+					}
+				}
+				else if(strcmp(argv[i], "--benchmark") == 0) {
+					sdfgen::args.benchmark = true;
+				}
+				else if(strcmp(argv[i], "--variants") == 0) {
+					if(argc > i + 1) {
+						sdfgen::args.variant_list = argv[++i];
+					}
+				}
+				else if(strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--format") == 0) {
+					if(argc > i + 1) {
+						const char * name = argv[++i];
+						if(strcmp(name, "rgba8") == 0) sdfgen::args.format = sdfgen::image::pixel_format::rgba8;
+						else if(strcmp(name, "r8") == 0) sdfgen::args.format = sdfgen::image::pixel_format::r8;
+						else if(strcmp(name, "r32f") == 0) sdfgen::args.format = sdfgen::image::pixel_format::r32f;
+						else if(strcmp(name, "r16f") == 0) sdfgen::args.format = sdfgen::image::pixel_format::r16f;
+						else {
+							std::cout << "Unknown format \"" << name << "\" (expected rgba8, r8, r32f or r16f)" << std::endl;
+							return -1;
+						}
+					}
+				}
 			}
 			else {
 				sdfgen::args.input_file = argv[i];
 			}
 		}
+		// Variants without a downscale take the one given anywhere on the command line:
+		if(!sdfgen::args.variant_list.empty() && !sdfgen::parse_variants(sdfgen::args.variant_list, sdfgen::args.downscale, sdfgen::args.variants)) {
+			std::cout << "Invalid variants \"" << sdfgen::args.variant_list << "\" (expected spread:downscale pairs such as 32:4,16:2,8:1)" << std::endl;
+			return -1;
+		}
+
 		// Make sure at least a input image was given as an argument:
 		if(sdfgen::args.input_file.empty()) {
 			std::cout << "At least the input file argument is required" << std::endl;
@@ -79,14 +167,49 @@ int main(int argc, char *argv[])
 	// ------------------------------------------------------------------------
 	// CHECK & OPEN IMAGE:
 
-	if(sdfgen::args.verbose) std::cout << "Loading source image \"" << sdfgen::args.input_file << "\" ..." << std::endl;
+	// A single field is generated straight from the file, without ever holding the whole image as rgba8:
 	sdfgen::image_ptr source_image;
-	try {
-		source_image = std::make_shared<sdfgen::image>(sdfgen::args.input_file);
+	if(sdfgen::args.benchmark || !sdfgen::args.variants.empty()) {
+		if(sdfgen::args.verbose) std::cout << "Loading source image \"" << sdfgen::args.input_file << "\" ..." << std::endl;
+		try {
+			source_image = std::make_shared<sdfgen::image>(sdfgen::args.input_file);
+		}
+		catch(std::exception e) {
+			std::cerr << "Failed to open source image: " << e.what() << std::endl;
+			return -1;
+		}
 	}
-	catch(std::exception e) {
-		std::cerr << "Failed to open source image: " << e.what() << std::endl;
-		return -1;
+
+	// ------------------------------------------------------------------------
+	// BENCHMARK:
+
+	if(sdfgen::args.benchmark) {
+		sdfgen::sdf_generator bench_gen(0x00000000, sdfgen::args.spread, sdfgen::args.downscale);
+		bench_gen.set_threads(sdfgen::args.threads);
+		bench_gen.set_algorithm(sdfgen::args.algorithm);
+		bench_gen.set_format(sdfgen::args.format);
+
+		// The best of a few runs each, the first one also warms up the caches and the thread pool:
+		const int runs = 3;
+		try {
+			for(const bool blocking : { false, true }) {
+				bench_gen.set_cache_blocking(blocking);
+				long long best = -1;
+				for(int run = 0; run < runs; ++run) {
+					auto bench_t1 = sdfgen::clock::now();
+					bench_gen.generate(source_image);
+					auto bench_t2 = sdfgen::clock::now();
+					const long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(bench_t2 - bench_t1).count();
+					if(best < 0 || ms < best) best = ms;
+				}
+				std::cout << sdfgen::sdf_generator::algorithm_name(sdfgen::args.algorithm) << (blocking ? ", cache blocks: " : ", row by row: ") << best << " ms" << std::endl;
+			}
+		}
+		catch(std::exception e) {
+			std::cerr << "Failed to generate signed distance field: " << e.what() << std::endl;
+			return -1;
+		}
+		return 0;
 	}
 
 	// ------------------------------------------------------------------------
@@ -96,37 +219,84 @@ int main(int argc, char *argv[])
 		std::cout 
 			<< "Generating Signed Distance Field (spread = " 
 			<< std::setprecision(2) << std::hex << sdfgen::args.spread 
-			<< std::dec << ", downscale = " << sdfgen::args.downscale << ")" 
+			<< std::dec << ", downscale = " << sdfgen::args.downscale 
+			<< ", algorithm = " << sdfgen::sdf_generator::algorithm_name(sdfgen::args.algorithm)
+			<< ", threads = " << (sdfgen::args.threads ? std::to_string(sdfgen::args.threads) : "auto")
+			<< (sdfgen::args.variants.empty() ? "" : ", variants = " + std::to_string(sdfgen::args.variants.size())) << ")" 
 			<< std::endl;
 		std::cout << "Please wait ...";
 	}
 
 	auto sdfgen_t1 = sdfgen::clock::now();
 
+	// With variants, the first one is previewed and all of them are saved:
 	sdfgen::image_ptr output_image = nullptr;
+	sdfgen::image_ptr display_image = nullptr;
+	std::vector<sdfgen::image_ptr> variant_images;
+	sdfgen::sdf_generator gen(0x00000000, sdfgen::args.spread, sdfgen::args.downscale);
 	try {
-		sdfgen::sdf_generator gen(0x00000000, sdfgen::args.spread, sdfgen::args.downscale);
-		output_image = gen.generate(source_image);
+		gen.set_threads(sdfgen::args.threads);
+		gen.set_algorithm(sdfgen::args.algorithm);
+		gen.set_format(sdfgen::args.format);
+		if(!sdfgen::args.variants.empty()) {
+			variant_images = gen.generate_variants(*source_image, sdfgen::args.variants);
+			output_image = variant_images.front();
+			gen.set_spread(sdfgen::args.variants.front().spread);
+		}
+		else {
+			output_image = gen.generate_file(sdfgen::args.input_file);
+		}
+
+		// Other formats are encoded as rgba8 for the previews and the error measurement:
+		display_image = sdfgen::args.format == sdfgen::image::pixel_format::rgba8 ? output_image : gen.encode(*output_image);
 	}
 	catch(std::exception e) {
 		std::cerr << std::endl << "Failed to generate signed distance field: " << e.what() << std::endl;
 		return -1;
 	}
 
-	//diewald::DRA dra;
-	//dra.init(source_image, 6, 0xFF000000);
-	//dra.createDistanceMap();
-	//output_image = dra.getImage();
-
 	auto sdfgen_t2 = sdfgen::clock::now();
 	std::cout << " [" << std::chrono::duration_cast<std::chrono::milliseconds>(sdfgen_t2 - sdfgen_t1).count() << " ms]" << std::endl;
 
+	// Dead reckoning, jump flooding and the coverage algorithms are approximate, show how far off they are from the exact distance transform.
+	// That decodes the input again and runs the full transform, so only when asked for:
+	if(sdfgen::args.measure_error && sdfgen::args.variants.empty() && (sdfgen::args.algorithm == sdfgen::sdf_generator::algorithm::dead_reckoning || sdfgen::args.algorithm == sdfgen::sdf_generator::algorithm::jump_flood || sdfgen::args.algorithm == sdfgen::sdf_generator::algorithm::coverage || sdfgen::args.algorithm == sdfgen::sdf_generator::algorithm::grayscale)) {
+		try {
+			sdfgen::sdf_generator exact_gen(0x00000000, sdfgen::args.spread, sdfgen::args.downscale);
+			exact_gen.set_threads(sdfgen::args.threads);
+			exact_gen.set_algorithm(sdfgen::sdf_generator::algorithm::edt);
+			sdfgen::image_ptr exact_image = exact_gen.generate_file(sdfgen::args.input_file);
+
+			const uint32_t * exact_pixels = (const uint32_t *) exact_image->pixels();
+			const uint32_t * output_pixels = (const uint32_t *) display_image->pixels();
+			int max_error = 0;
+			for(uint32_t i = 0; i < output_image->width() * output_image->height(); ++i) {
+				max_error = std::max<int>(max_error, std::abs((int) (output_pixels[i] >> 24) - (int) (exact_pixels[i] >> 24)));
+			}
+
+			// An alpha step of 1/255 covers 2 * spread / 255 pixels:
+			std::cout
+				<< "Maximum error against the exact distance: " << max_error << " alpha levels ("
+				<< std::setprecision(3) << max_error * 2.0f * sdfgen::args.spread / 255.0f << " pixels)" << std::endl;
+		}
+		catch(std::exception e) {
+			std::cerr << "Failed to measure the error against the exact distance: " << e.what() << std::endl;
+		}
+	}
+
 	// ------------------------------------------------------------------------
 	// SAVE SDF OUTPUT IMAGE TO FILE:
 	if(!sdfgen::args.output_sdf_file.empty()) {
 		if(sdfgen::args.verbose) std::cout << "Saving output to \"" << sdfgen::args.output_sdf_file << "\" ..." << std::endl;
 		try {
-			output_image->save(sdfgen::args.output_sdf_file);
+			const bool is_float = sdfgen::args.format == sdfgen::image::pixel_format::r32f || sdfgen::args.format == sdfgen::image::pixel_format::r16f;
+			const sdfgen::image::file_format file_format = is_float ? sdfgen::image::file_format::raw : sdfgen::image::file_format::png;
+			if(sdfgen::args.variants.empty()) {
+				output_image->save(sdfgen::args.output_sdf_file, file_format);
+			}
+			for(size_t i = 0; i < variant_images.size(); ++i) {
+				variant_images[i]->save(sdfgen::variant_file(sdfgen::args.output_sdf_file, sdfgen::args.variants[i]), file_format);
+			}
 		}
 		catch(std::exception e) {
 			std::cerr << "Failed to write image: " << e.what() << std::endl;
@@ -142,8 +312,8 @@ int main(int argc, char *argv[])
 	sdfgen::preview_window sdf_preview(false), out_preview(false);
 	try {
 		sdfgen::preview_window::initialize();
-		sdf_preview.create("SDF Render Preview", *output_image, 1024, 1024, sdfgen::preview_window::sdf_shader, "../shaders/basic_vertex.glsl", "../shaders/sdf_fragment.glsl", 0xFFFFFFFF, 0x333333FF);
-		out_preview.create("SDF Output Preview", *output_image, sdfgen::preview_window::basic_shader, "../shaders/basic_vertex.glsl", "../shaders/basic_fragment.glsl", 0xFFFFFFFF, 0x333333FF);
+		sdf_preview.create("SDF Render Preview", *display_image, 1024, 1024, sdfgen::preview_window::sdf_shader, "../shaders/basic_vertex.glsl", "../shaders/sdf_fragment.glsl", 0xFFFFFFFF, 0x333333FF);
+		out_preview.create("SDF Output Preview", *display_image, sdfgen::preview_window::basic_shader, "../shaders/basic_vertex.glsl", "../shaders/basic_fragment.glsl", 0xFFFFFFFF, 0x333333FF);
 	}
 	catch(std::exception e) {
 		std::cerr << "Failed to create SDF Preview Window: " << e.what() << std::endl;
@@ -1,5 +1,16 @@
 #include "sdf_generator.h"
+#include "distance_transform.h"
+#include "simd_kernels.h"
+#include "dead_reckoning.h"
+#include "jump_flood.h"
+#include "edge_grid.h"
+#include "summed_area_table.h"
+#include "antialiased_edt.h"
+#include "window_search.h"
+#include <stb_image.h>
 #include <algorithm>
+#include <vector>
+#include <unordered_map>
 
 #undef min
 #undef max
@@ -7,7 +18,7 @@
 using namespace sdfgen;
 
 sdf_generator::sdf_generator(const uint32_t color, const float spread, const int32_t downscale)
-	: m_color(color), m_spread(spread), m_downscale(downscale)
+	: m_color(color), m_spread(spread), m_downscale(downscale), m_algorithm(default_algorithm), m_threads(default_threads), m_format(image::pixel_format::rgba8), m_lookup(true), m_cache_blocking(true), m_kernels(&get_simd_kernels()), m_offsets_delta(-1), m_lookup_spread(0), m_lookup_color(0), m_lookup_format(image::pixel_format::rgba8)
 {
 
 }
@@ -23,38 +34,1115 @@ image_ptr sdf_generator::generate(const image& input_image)
 	const uint32_t in_height = input_image.height();
 	const uint32_t out_width = in_width / m_downscale;
 	const uint32_t out_height = in_height / m_downscale;
-	const uint32_t bits = input_image.bits();
-	bool * bitmap = new bool[in_width * in_height];
+	image_ptr out_image = std::make_shared<sdfgen::image>(out_width, out_height, m_format);
+	byte_ptr out_pixels = out_image->pixels();
+
+	// Grayscale reads the pixels directly and never needs the two-color mask:
+	if(m_algorithm == algorithm::grayscale) {
+		m_mask = bitmap();
+		generate_grayscale(input_image, out_pixels, out_width, out_height);
+		return out_image;
+	}
+
+	// The mask is kept for regenerate():
+	m_mask = bitmap(in_width, in_height);
+	threshold(input_image, m_mask);
+	generate_from_mask(m_mask, out_pixels, out_width, out_height);
+
+	return out_image;
+}
+
+image_ptr sdf_generator::generate_file(const std::string& file)
+{
+	// Grayscale reads the pixels directly and never needs the two-color mask:
+	if(m_algorithm == algorithm::grayscale) {
+		return generate(image(file));
+	}
+
+	int width = 0, height = 0, channels = 0;
+	stbi_uc * pixels = stbi_load(file.c_str(), &width, &height, &channels, 0);
+	if(pixels == NULL) {
+		throw std::exception(stbi_failure_reason());
+	}
+
+	// The mask is kept for regenerate(), the decoded pixels are dropped before generating:
+	m_mask = bitmap((uint32_t) width, (uint32_t) height);
+	threshold(pixels, (uint32_t) channels, m_mask);
+	stbi_image_free(pixels);
+
+	const uint32_t out_width = m_mask.width() / m_downscale;
+	const uint32_t out_height = m_mask.height() / m_downscale;
+	image_ptr out_image = std::make_shared<sdfgen::image>(out_width, out_height, m_format);
+	generate_from_mask(m_mask, out_image->pixels(), out_width, out_height);
+
+	return out_image;
+}
+
+image_ptr sdf_generator::generate_packed(const std::vector<image_ptr>& input_images)
+{
+	if(input_images.empty() || input_images.size() > 4) {
+		throw std::exception("Between one and four images can be packed into one");
+	}
+
+	const uint32_t in_width = input_images[0]->width();
+	const uint32_t in_height = input_images[0]->height();
+	for(const image_ptr& input_image : input_images) {
+		if(input_image->width() != in_width || input_image->height() != in_height) {
+			throw std::exception("The packed images must all have the same size");
+		}
+	}
+
+	const uint32_t out_width = in_width / m_downscale;
+	const uint32_t out_height = in_height / m_downscale;
 	image_ptr out_image = std::make_shared<sdfgen::image>(out_width, out_height);
-	float signed_distance = 0.0f;
-	const uint32_t * in_pixels = (const uint32_t*) input_image.pixels();
-	uint32_t * out_pixels = (uint32_t*) out_image->pixels();
-	
+	byte_ptr out_pixels = out_image->pixels();
 
-	for(uint32_t y = 0; y < in_height; ++y) {
-		for(uint32_t x = 0; x < in_width; ++x) {
-			bitmap[y * in_width + x] = is_inside(in_pixels[y * in_width + x]);
+	// Every channel is generated as r8 into the same buffer, then spread into the output:
+	const image::pixel_format format = set_format(image::pixel_format::r8);
+	bitmap mask(in_width, in_height);
+	std::vector<byte> channel((size_t) out_width * out_height);
+
+	try {
+		for(uint32_t c = 0; c < input_images.size(); ++c) {
+			if(m_algorithm == algorithm::grayscale) {
+				generate_grayscale(*input_images[c], channel.data(), out_width, out_height);
+			}
+			else {
+				threshold(*input_images[c], mask);
+				generate_from_mask(mask, channel.data(), out_width, out_height);
+			}
+
+			pool().parallel_for(0, out_height, [&](const uint32_t begin, const uint32_t end) {
+				for(size_t i = (size_t) begin * out_width; i < (size_t) end * out_width; ++i) {
+					out_pixels[i * 4 + c] = channel[i];
+				}
+			});
 		}
 	}
-	
-	for(uint32_t y = 0; y < out_height; ++y) {
-		for(uint32_t x = 0; x < out_width; ++x) {
-			signed_distance = find_signed_distance(
-				(x * m_downscale) + (m_downscale / 2),
-				(y * m_downscale) + (m_downscale / 2),
-				bitmap, 
-				in_width, 
-				in_height
-			);
-			out_pixels[y * out_width + x] = distance_to_rgb(signed_distance);
+	catch(...) {
+		set_format(format);
+		throw;
+	}
+
+	set_format(format);
+	return out_image;
+}
+
+sdf_generator::label_field sdf_generator::generate_labels(const image& input_image)
+{
+	const uint32_t in_width = input_image.width();
+	const uint32_t in_height = input_image.height();
+	const uint32_t out_width = in_width / m_downscale;
+	const uint32_t out_height = in_height / m_downscale;
+	const uint32_t * in_pixels = (const uint32_t *) input_image.pixels();
+
+	label_field result;
+	result.distances = std::make_shared<sdfgen::image>(out_width, out_height, m_format);
+	result.nearest_labels.assign((size_t) out_width * out_height, no_label);
+
+	// Number the labels in order of appearance. Labels come in runs, so most pixels skip the lookup:
+	std::unordered_map<uint32_t, uint32_t> ids;
+	for(size_t i = 0; i < (size_t) in_width * in_height; ++i) {
+		if(i > 0 && in_pixels[i] == in_pixels[i - 1]) continue;
+		if(ids.emplace(in_pixels[i], (uint32_t) result.colors.size()).second) result.colors.push_back(in_pixels[i]);
+	}
+
+	// The closest pixel of another label always touches a pixel of the center's label on the way
+	// towards the center, so only pixels next to another label can be it:
+	bitmap border(in_width, in_height);
+	pool().parallel_for(0, in_height, [&](const uint32_t begin, const uint32_t end) {
+		for(uint32_t y = begin; y < end; ++y) {
+			const uint32_t * row = in_pixels + (size_t) y * in_width;
+			const uint32_t * up = y > 0 ? row - in_width : row;
+			const uint32_t * down = y + 1 < in_height ? row + in_width : row;
+			for(uint32_t x = 0; x < in_width; ++x) {
+				const uint32_t color = row[x];
+				if((x > 0 && row[x - 1] != color) || (x + 1 < in_width && row[x + 1] != color) || up[x] != color || down[x] != color) {
+					border.set(x, y, true);
+				}
+			}
+		}
+	});
+
+	if(out_width == 0 || out_height == 0) return result;
+
+	// Nothing of another label is closer than the closest border pixel, which the exact transform
+	// of the border finds in linear time. The walk then starts at that distance:
+	const std::vector<offset>& offsets = sorted_offsets();
+	const int32_t limit = (int32_t) ceil(m_spread);
+	const int32_t half = (int32_t) m_downscale / 2;
+	std::vector<int32_t> to_outside((size_t) out_height * in_width);
+	std::vector<int32_t> to_border((size_t) out_height * in_width);
+
+	pool().parallel_for(0, in_width, [&](const uint32_t begin, const uint32_t end) {
+		distance_transform::column_pass(
+			border,
+			(int32_t) begin, (int32_t) end,
+			half, (int32_t) m_downscale, (int32_t) out_height,
+			limit, to_outside.data(), to_border.data()
+		);
+	});
+
+	pool().parallel_for(0, out_height, [&](const uint32_t begin, const uint32_t end) {
+		distance_transform transform;
+		std::vector<int32_t> border_row(in_width);
+		std::vector<float> signed_distances(out_width);
+
+		for(uint32_t y = begin; y < end; ++y) {
+			transform.row_pass(&to_border[(size_t) y * in_width], (int32_t) in_width, limit, border_row.data());
+
+			for(uint32_t x = 0; x < out_width; ++x) {
+				const uint32_t center_x = x * m_downscale + half;
+				const int32_t closest_border = border_row[center_x];
+				if(closest_border >= limit * limit) {
+					signed_distances[x] = m_spread;
+					continue;
+				}
+
+				const auto first = std::lower_bound(offsets.begin(), offsets.end(), closest_border, [](const offset& o, const int32_t square_distance) {
+					return o.square_distance < square_distance;
+				});
+				uint32_t color = 0;
+				const int square_distance = find_nearest_label(center_x, y * m_downscale + half, input_image, border, first, offsets.end(), color);
+				signed_distances[x] = to_signed_distance(square_distance, true);
+				if(signed_distances[x] < m_spread) result.nearest_labels[(size_t) y * out_width + x] = ids.find(color)->second;
+			}
+			encode_row(signed_distances.data(), out_width, result.distances->pixels(), y);
+		}
+	});
+
+	return result;
+}
+
+image_ptr sdf_generator::generate_nearest(const image& input_image, std::vector<feature_offset>& nearest)
+{
+	const int32_t delta = (int32_t) ceil(m_spread);
+	if(delta > INT16_MAX) {
+		throw std::exception("The spread is too large for 16-bit offsets");
+	}
+
+	const uint32_t in_width = input_image.width();
+	const uint32_t in_height = input_image.height();
+	const uint32_t out_width = in_width / m_downscale;
+	const uint32_t out_height = in_height / m_downscale;
+	image_ptr out_image = std::make_shared<sdfgen::image>(out_width, out_height, m_format);
+	nearest.assign((size_t) out_width * out_height, { 0, 0 });
+
+	bitmap mask(in_width, in_height);
+	threshold(input_image, mask);
+
+	const std::vector<offset>& offsets = sorted_offsets();
+	const uint32_t tiles_x = (out_width + tile_size - 1) / tile_size;
+	std::vector<tile_class> tiles;
+	classify_tiles(mask, out_width, out_height, tiles);
+
+	pool().parallel_for(0, out_height, [&](const uint32_t begin, const uint32_t end) {
+		std::vector<float> signed_distances(out_width);
+
+		for(uint32_t y = begin; y < end; ++y) {
+			const tile_class * tile_row = &tiles[(size_t) (y / tile_size) * tiles_x];
+			for(uint32_t x = 0; x < out_width; ++x) {
+				const tile_class tile = tile_row[x / tile_size];
+				if(tile != tile_mixed) {
+					signed_distances[x] = tile == tile_inside ? m_spread : -m_spread;
+					continue;
+				}
+
+				const int center_x = (x * m_downscale) + (m_downscale / 2);
+				const int center_y = (y * m_downscale) + (m_downscale / 2);
+				const bool inside = mask.get(center_x, center_y);
+				const offset * closest = find_nearest_spiral(center_x, center_y, mask, offsets);
+				if(closest) nearest[(size_t) y * out_width + x] = { (int16_t) closest->dx, (int16_t) closest->dy };
+				signed_distances[x] = to_signed_distance(closest ? closest->square_distance : delta * delta, inside);
+			}
+			encode_row(signed_distances.data(), out_width, out_image->pixels(), y);
+		}
+	});
+
+	return out_image;
+}
+
+std::vector<image_ptr> sdf_generator::generate_variants(const image& input_image, const std::vector<variant>& variants)
+{
+	if(variants.empty()) {
+		throw std::exception("At least one variant is required");
+	}
+
+	float largest_spread = 0;
+	for(const variant& v : variants) {
+		if(!(v.spread > 0) || v.downscale < 1) {
+			throw std::exception("Every variant needs a positive spread and downscale");
+		}
+		largest_spread = std::max<float>(largest_spread, v.spread);
+	}
+
+	const uint32_t in_width = input_image.width();
+	const uint32_t in_height = input_image.height();
+	std::vector<image_ptr> out_images;
+	for(const variant& v : variants) {
+		out_images.push_back(std::make_shared<sdfgen::image>(in_width / v.downscale, in_height / v.downscale, m_format));
+	}
+	if(in_width == 0 || in_height == 0) return out_images;
+
+	bitmap mask(in_width, in_height);
+	threshold(input_image, mask);
+
+	// Limiting to the largest spread gives the same result for every smaller spread,
+	// as distances are limited to ceil(spread) and then to the spread itself anyway:
+	const int32_t limit = (int32_t) ceil(largest_spread);
+	std::vector<int32_t> to_outside((size_t) in_height * in_width);
+	std::vector<int32_t> to_inside((size_t) in_height * in_width);
+
+	pool().parallel_for(0, in_width, [&](const uint32_t begin, const uint32_t end) {
+		distance_transform::column_pass(
+			mask,
+			(int32_t) begin, (int32_t) end,
+			0, 1, (int32_t) in_height,
+			limit, to_outside.data(), to_inside.data()
+		);
+	});
+
+	// Only the rows some variant samples need the second pass, and each of them is handed to every variant sampling it:
+	pool().parallel_for(0, in_height, [&](const uint32_t begin, const uint32_t end) {
+		distance_transform transform;
+		std::vector<int32_t> outside_row(in_width), inside_row(in_width);
+		std::vector<float> signed_distances(in_width);
+
+		for(uint32_t y = begin; y < end; ++y) {
+			bool transformed = false;
+
+			for(size_t i = 0; i < variants.size(); ++i) {
+				const uint32_t downscale = (uint32_t) variants[i].downscale;
+				const uint32_t out_width = out_images[i]->width();
+				const uint32_t out_y = y / downscale;
+				if(y % downscale != downscale / 2 || out_y >= out_images[i]->height()) continue;
+
+				if(!transformed) {
+					transform.row_pass(&to_outside[(size_t) y * in_width], (int32_t) in_width, limit, outside_row.data());
+					transform.row_pass(&to_inside[(size_t) y * in_width], (int32_t) in_width, limit, inside_row.data());
+					transformed = true;
+				}
+
+				for(uint32_t x = 0; x < out_width; ++x) {
+					const uint32_t center_x = x * downscale + downscale / 2;
+					const bool inside = mask.get(center_x, y);
+					const float closest_distance = (float) sqrt(inside ? outside_row[center_x] : inside_row[center_x]);
+					signed_distances[x] = (inside ? 1 : -1) * std::min<float>(closest_distance, variants[i].spread);
+				}
+				encode_row(signed_distances.data(), out_width, out_images[i]->pixels(), out_y, variants[i].spread);
+			}
+		}
+	});
+
+	return out_images;
+}
+
+void sdf_generator::regenerate(const image& input_image, image& output_image, const std::vector<rectangle>& dirty)
+{
+	const uint32_t in_width = input_image.width();
+	const uint32_t in_height = input_image.height();
+	const uint32_t out_width = in_width / m_downscale;
+	const uint32_t out_height = in_height / m_downscale;
+	if(output_image.width() != out_width || output_image.height() != out_height || output_image.format() != m_format) {
+		throw std::exception("The output image does not match the input image");
+	}
+
+	byte_ptr out_pixels = output_image.pixels();
+	if(m_algorithm != algorithm::grayscale && (m_mask.width() != in_width || m_mask.height() != in_height)) {
+		const image_ptr full = generate(input_image);
+		std::memcpy(out_pixels, full->pixels(), full->length());
+		return;
+	}
+
+	// Changes reach the output pixels sampled within the spread, plus the one output pixel the
+	// anti-aliased transform looks beyond it:
+	const uint32_t * in_pixels = (const uint32_t *) input_image.pixels();
+	const int64_t reach = (int64_t) ceil(m_spread) + m_downscale;
+
+	for(const rectangle& area : dirty) {
+		const uint32_t left = std::min<uint32_t>(area.x, in_width);
+		const uint32_t top = std::min<uint32_t>(area.y, in_height);
+		const uint32_t right = (uint32_t) std::min<uint64_t>(in_width, (uint64_t) area.x + area.width);
+		const uint32_t bottom = (uint32_t) std::min<uint64_t>(in_height, (uint64_t) area.y + area.height);
+		if(left >= right || top >= bottom) continue;
+
+		if(m_algorithm != algorithm::grayscale) {
+			pool().parallel_for(top, bottom, [&](const uint32_t begin, const uint32_t end) {
+				for(uint32_t y = begin; y < end; ++y) {
+					for(uint32_t x = left; x < right; ++x) {
+						m_mask.set(x, y, is_inside(in_pixels[(size_t) y * in_width + x]));
+					}
+				}
+			});
+		}
+
+		const uint32_t out_left = (uint32_t) std::max<int64_t>(0, ((int64_t) left - reach) / m_downscale);
+		const uint32_t out_top = (uint32_t) std::max<int64_t>(0, ((int64_t) top - reach) / m_downscale);
+		const uint32_t out_right = (uint32_t) std::min<int64_t>(out_width, ((int64_t) right + reach) / m_downscale + 1);
+		const uint32_t out_bottom = (uint32_t) std::min<int64_t>(out_height, ((int64_t) bottom + reach) / m_downscale + 1);
+		if(out_left >= out_right || out_top >= out_bottom) continue;
+
+		regenerate_region(input_image, out_pixels, out_width, { out_left, out_top, out_right - out_left, out_bottom - out_top });
+	}
+}
+
+void sdf_generator::regenerate_region(const image& input_image, byte_ptr out_pixels, const uint32_t out_width, const rectangle& area)
+{
+	const rectangle window = input_window(area, input_image.width(), input_image.height());
+	const uint32_t window_out_width = window.width / m_downscale;
+	const uint32_t window_out_height = window.height / m_downscale;
+	const uint32_t pixel_size = image::bytes_per_pixel(m_format);
+	std::vector<byte> window_pixels((size_t) window_out_width * window_out_height * pixel_size);
+
+	if(m_algorithm == algorithm::grayscale) {
+		const uint32_t * in_pixels = (const uint32_t *) input_image.pixels();
+		image region(window.width, window.height);
+		for(uint32_t y = 0; y < window.height; ++y) {
+			std::memcpy((uint32_t *) region.pixels() + (size_t) y * window.width, in_pixels + (size_t) (window.y + y) * input_image.width() + window.x, window.width * sizeof(uint32_t));
+		}
+		generate_grayscale(region, window_pixels.data(), window_out_width, window_out_height);
+	}
+	else {
+		generate_from_mask(m_mask.region(window.x, window.y, window.width, window.height), window_pixels.data(), window_out_width, window_out_height);
+	}
+
+	const uint32_t offset_x = area.x - window.x / m_downscale;
+	const uint32_t offset_y = area.y - window.y / m_downscale;
+	for(uint32_t y = 0; y < area.height; ++y) {
+		std::memcpy(
+			out_pixels + ((size_t) (area.y + y) * out_width + area.x) * pixel_size,
+			&window_pixels[((size_t) (offset_y + y) * window_out_width + offset_x) * pixel_size],
+			area.width * pixel_size
+		);
+	}
+}
+
+sdf_generator::rectangle sdf_generator::input_window(const rectangle& area, const uint32_t in_width, const uint32_t in_height) const
+{
+	// The window starts on a multiple of the downscale so that its samples line up with the whole image's:
+	const uint32_t halo = tile_halo();
+	const uint32_t left = (uint32_t) std::max<int64_t>(0, (int64_t) area.x * m_downscale - halo);
+	const uint32_t top = (uint32_t) std::max<int64_t>(0, (int64_t) area.y * m_downscale - halo);
+	const uint32_t right = (uint32_t) std::min<uint64_t>(in_width, (uint64_t) (area.x + area.width) * m_downscale + halo);
+	const uint32_t bottom = (uint32_t) std::min<uint64_t>(in_height, (uint64_t) (area.y + area.height) * m_downscale + halo);
+	return { left, top, right - left, bottom - top };
+}
+
+void sdf_generator::threshold(const image& input_image, bitmap& mask)
+{
+	const uint32_t in_width = input_image.width();
+	const uint32_t * in_pixels = (const uint32_t *) input_image.pixels();
+
+	pool().parallel_for(0, input_image.height(), [&](const uint32_t begin, const uint32_t end) {
+		for(uint32_t y = begin; y < end; ++y) {
+			threshold_row(in_pixels + (size_t) y * in_width, in_width, mask.row(y));
+		}
+	});
+}
+
+void sdf_generator::threshold(const byte * pixels, const uint32_t channels, bitmap& mask)
+{
+	const uint32_t in_width = mask.width();
+
+	pool().parallel_for(0, mask.height(), [&](const uint32_t begin, const uint32_t end) {
+		for(uint32_t y = begin; y < end; ++y) {
+			const byte * row = pixels + (size_t) y * in_width * channels;
+			switch(channels) {
+			case 1: threshold_row<1>(row, in_width, mask.row(y)); break;
+			case 2: threshold_row<2>(row, in_width, mask.row(y)); break;
+			case 3: threshold_row<3>(row, in_width, mask.row(y)); break;
+			default: threshold_row((const uint32_t *) row, in_width, mask.row(y)); break;
+			}
+		}
+	});
+}
+
+void sdf_generator::encode_row(const float * signed_distances, const uint32_t out_width, byte_ptr out_pixels, const uint32_t y, const float spread) const
+{
+	byte_ptr out_row = out_pixels + (size_t) y * out_width * image::bytes_per_pixel(m_format);
+
+	switch(m_format) {
+	case image::pixel_format::r32f:
+		std::memcpy(out_row, signed_distances, out_width * sizeof(float));
+		break;
+	case image::pixel_format::r16f:
+		m_kernels->encode_half(signed_distances, out_width, (uint16_t *) out_row);
+		break;
+	case image::pixel_format::r8:
+		m_kernels->encode_alpha(signed_distances, out_width, spread, out_row);
+		break;
+	case image::pixel_format::rgba8:
+	default:
+		m_kernels->encode_rgba(signed_distances, out_width, spread, m_color, (uint32_t *) out_row);
+		break;
+	}
+}
+
+image_ptr sdf_generator::encode(const image& distance_field)
+{
+	const image::pixel_format format = distance_field.format();
+	if(format == image::pixel_format::rgba8) {
+		throw std::exception("The distance field is already encoded as rgba8");
+	}
+
+	const uint32_t width = distance_field.width();
+	image_ptr out_image = std::make_shared<sdfgen::image>(width, distance_field.height());
+	uint32_t * out_pixels = (uint32_t *) out_image->pixels();
+
+	if(format == image::pixel_format::r8) {
+		const byte * alpha = distance_field.pixels();
+		for(size_t i = 0; i < (size_t) width * distance_field.height(); ++i) {
+			out_pixels[i] = ((uint32_t) alpha[i] << 24) | (m_color & 0xFFFFFF);
 		}
+		return out_image;
 	}
 
-	delete[] bitmap;
-	
+	pool().parallel_for(0, distance_field.height(), [&](const uint32_t begin, const uint32_t end) {
+		std::vector<float> signed_distances(width);
+
+		for(uint32_t y = begin; y < end; ++y) {
+			const float * row = (const float *) distance_field.pixels() + (size_t) y * width;
+			if(format == image::pixel_format::r16f) {
+				m_kernels->decode_half((const uint16_t *) distance_field.pixels() + (size_t) y * width, width, signed_distances.data());
+				row = signed_distances.data();
+			}
+			m_kernels->encode_rgba(row, width, m_spread, m_color, out_pixels + (size_t) y * width);
+		}
+	});
+
 	return out_image;
 }
 
+void sdf_generator::update_lookup_table()
+{
+	const int32_t delta = (int32_t) ceil(m_spread);
+	if(!m_lookup || delta > max_lookup_delta) {
+		m_lookup_table.clear();
+		return;
+	}
+	if(!m_lookup_table.empty() && m_lookup_spread == m_spread && m_lookup_color == m_color && m_lookup_format == m_format) return;
+
+	// Every signed square from ~limit to limit, encoded by the float path itself so that both give the same pixels:
+	const int32_t limit = delta * delta;
+	std::vector<float> signed_distances(2 * (size_t) limit + 2);
+	for(int32_t i = 0; i < (int32_t) signed_distances.size(); ++i) {
+		const int32_t code = i - limit - 1;
+		signed_distances[i] = to_signed_distance(code >= 0 ? code : ~code, code >= 0);
+	}
+
+	m_lookup_table.resize(signed_distances.size() * image::bytes_per_pixel(m_format));
+	encode_row(signed_distances.data(), (uint32_t) signed_distances.size(), m_lookup_table.data(), 0);
+	m_lookup_spread = m_spread;
+	m_lookup_color = m_color;
+	m_lookup_format = m_format;
+}
+
+void sdf_generator::encode_square_row(const int32_t * signed_squares, float * signed_distances, const uint32_t out_width, byte_ptr out_pixels, const uint32_t y) const
+{
+	if(m_lookup_table.empty()) {
+		for(uint32_t x = 0; x < out_width; ++x) {
+			const int32_t code = signed_squares[x];
+			signed_distances[x] = to_signed_distance(code >= 0 ? code : ~code, code >= 0);
+		}
+		encode_row(signed_distances, out_width, out_pixels, y);
+		return;
+	}
+
+	const int32_t delta = (int32_t) ceil(m_spread);
+	const int32_t first = delta * delta + 1;
+	switch(image::bytes_per_pixel(m_format)) {
+	case 1:
+		lookup_row(signed_squares, out_width, m_lookup_table.data() + first, out_pixels + (size_t) y * out_width);
+		break;
+	case 2:
+		lookup_row(signed_squares, out_width, (const uint16_t *) m_lookup_table.data() + first, (uint16_t *) out_pixels + (size_t) y * out_width);
+		break;
+	default:
+		lookup_row(signed_squares, out_width, (const uint32_t *) m_lookup_table.data() + first, (uint32_t *) out_pixels + (size_t) y * out_width);
+		break;
+	}
+}
+
+void sdf_generator::generate_from_mask(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	update_lookup_table();
+
+	switch(m_algorithm) {
+	case algorithm::edt:
+		generate_edt(mask, out_pixels, out_width, out_height);
+		break;
+	case algorithm::spiral:
+		generate_spiral(mask, out_pixels, out_width, out_height);
+		break;
+	case algorithm::dead_reckoning:
+		generate_dead_reckoning(mask, out_pixels, out_width, out_height);
+		break;
+	case algorithm::jump_flood:
+		generate_jump_flood(mask, out_pixels, out_width, out_height);
+		break;
+	case algorithm::edge_grid:
+		generate_edge_grid(mask, out_pixels, out_width, out_height);
+		break;
+	case algorithm::coverage:
+		generate_coverage(mask, out_pixels, out_width, out_height);
+		break;
+	case algorithm::brute_force:
+	default:
+		generate_brute_force(mask, out_pixels, out_width, out_height);
+		break;
+	}
+}
+
+bool sdf_generator::generate_stream(const uint32_t in_width, const uint32_t in_height, const row_source& source, const row_sink& sink)
+{
+	const uint32_t out_width = in_width / m_downscale;
+	const uint32_t out_height = in_height / m_downscale;
+	const int delta = (int) ceil(m_spread);
+	const int64_t half = m_downscale / 2;
+
+	// Output rows are generated a chunk at a time, enough of them to keep every thread busy
+	// and to only move the band once per chunk:
+	const uint32_t chunk_rows = std::max<uint32_t>((2 * delta + m_downscale - 1) / m_downscale, pool().size() * 4);
+
+	update_lookup_table();
+	bitmap band(in_width, 0);
+	uint32_t band_first = 0;
+	uint32_t next_row = 0;
+	std::vector<uint32_t> in_row(in_width);
+	const size_t out_row_size = (size_t) out_width * image::bytes_per_pixel(m_format);
+	std::vector<byte> out_rows(chunk_rows * out_row_size);
+
+	for(uint32_t chunk_begin = 0; chunk_begin < out_height; chunk_begin += chunk_rows) {
+		const uint32_t chunk_end = std::min<uint32_t>(out_height, chunk_begin + chunk_rows);
+		const uint32_t first_needed = (uint32_t) std::max<int64_t>(0, (int64_t) chunk_begin * m_downscale + half - delta);
+		const uint32_t end_needed = (uint32_t) std::min<int64_t>(in_height, (int64_t) (chunk_end - 1) * m_downscale + half + delta + 1);
+
+		// Drop the rows no window reaches anymore, then read up to the last row this chunk needs.
+		// Rows between two bands that no window reaches are still read, but never kept:
+		band.drop_rows(first_needed - band_first);
+		band_first = first_needed;
+		for(; next_row < end_needed; ++next_row) {
+			if(!source(next_row, in_row.data())) return false;
+			if(next_row >= first_needed) threshold_row(in_row.data(), in_width, band.append_row());
+		}
+
+		pool().parallel_for(chunk_begin, chunk_end, [&](const uint32_t begin, const uint32_t end) {
+			std::vector<int32_t> row_distances(2 * delta + 1);
+			std::vector<int32_t> signed_squares(out_width);
+			std::vector<float> signed_distances(out_width);
+
+			for(uint32_t y = begin; y < end; ++y) {
+				const int center_y = (int) ((int64_t) y * m_downscale + half - band_first);
+				for(uint32_t x = 0; x < out_width; ++x) {
+					signed_squares[x] = find_signed_square((x * m_downscale) + (m_downscale / 2), center_y, band, row_distances.data());
+				}
+				encode_square_row(signed_squares.data(), signed_distances.data(), out_width, out_rows.data(), y - chunk_begin);
+			}
+		});
+
+		for(uint32_t y = chunk_begin; y < chunk_end; ++y) {
+			if(!sink(y, &out_rows[(y - chunk_begin) * out_row_size])) return false;
+		}
+	}
+
+	return true;
+}
+
+void sdf_generator::generate(tiled_image& input, tiled_image& output)
+{
+	if(output.width() != input.width() / m_downscale || output.height() != input.height() / m_downscale) {
+		throw std::exception("The output image must be downscale times smaller than the input image");
+	}
+	if(image::bytes_per_pixel(m_format) != sizeof(uint32_t)) {
+		throw std::exception("Tiled images hold 32-bit pixels, only rgba8 and r32f output are supported");
+	}
+
+	for(uint32_t tile_y = 0; tile_y < output.tiles_y(); ++tile_y) {
+		for(uint32_t tile_x = 0; tile_x < output.tiles_x(); ++tile_x) {
+			const uint32_t x = tile_x * output.tile_size();
+			const uint32_t y = tile_y * output.tile_size();
+			generate_region(input, output, x, y, std::min<uint32_t>(output.tile_size(), output.width() - x), std::min<uint32_t>(output.tile_size(), output.height() - y));
+		}
+	}
+}
+
+uint32_t sdf_generator::tile_halo() const
+{
+	// The window searches reach ceil(spread) pixels, the anti-aliased transform one output pixel further.
+	// Another output pixel of margin covers the approximate algorithms stopping early at the border:
+	const uint32_t delta = (uint32_t) ceil(m_spread);
+	return ((delta + m_downscale - 1) / m_downscale + 2) * m_downscale;
+}
+
+void sdf_generator::generate_region(tiled_image& input, tiled_image& output, const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height)
+{
+	if(width == 0 || height == 0) return;
+	if(image::bytes_per_pixel(m_format) != sizeof(uint32_t)) {
+		throw std::exception("Tiled images hold 32-bit pixels, only rgba8 and r32f output are supported");
+	}
+
+	const rectangle window = input_window({ x, y, width, height }, input.width(), input.height());
+	const uint32_t window_out_width = window.width / m_downscale;
+	const uint32_t window_out_height = window.height / m_downscale;
+	std::vector<uint32_t> window_pixels((size_t) window_out_width * window_out_height);
+
+	image region(window.width, window.height);
+	input.read_region(window.x, window.y, window.width, window.height, (uint32_t *) region.pixels(), region.width());
+
+	// Generated without touching the kept mask, which belongs to the last whole image:
+	if(m_algorithm == algorithm::grayscale) {
+		generate_grayscale(region, (byte_ptr) window_pixels.data(), window_out_width, window_out_height);
+	}
+	else {
+		bitmap mask(window.width, window.height);
+		threshold(region, mask);
+		generate_from_mask(mask, (byte_ptr) window_pixels.data(), window_out_width, window_out_height);
+	}
+
+	const uint32_t offset_x = x - window.x / m_downscale;
+	const uint32_t offset_y = y - window.y / m_downscale;
+	output.write_region(x, y, width, height, &window_pixels[(size_t) offset_y * window_out_width + offset_x], window_out_width);
+}
+
+void sdf_generator::threshold_row(const uint32_t * pixels, const uint32_t width, uint64_t * mask_row)
+{
+	for(uint32_t x = 0; x < width; x += bitmap::word_bits) {
+		const uint32_t count = std::min<uint32_t>(bitmap::word_bits, width - x);
+		uint64_t word = 0;
+		for(uint32_t bit = 0; bit < count; ++bit) {
+			word |= (uint64_t) is_inside(pixels[x + bit]) << bit;
+		}
+		mask_row[x / bitmap::word_bits] = word;
+	}
+}
+
+void sdf_generator::classify_tiles(const bitmap& mask, const uint32_t out_width, const uint32_t out_height, std::vector<tile_class>& tiles)
+{
+	const uint32_t tiles_x = (out_width + tile_size - 1) / tile_size;
+	const uint32_t tiles_y = (out_height + tile_size - 1) / tile_size;
+	tiles.assign((size_t) tiles_x * tiles_y, tile_mixed);
+	if(tiles.empty()) return;
+
+	summed_area_table sums;
+	sums.build(mask, pool());
+
+	// Pixels at ceil(spread) or further saturate anyway, so the window stops just short of them:
+	const int64_t reach = std::max<int64_t>(0, (int64_t) ceil(m_spread) - 1);
+	const int64_t half = m_downscale / 2;
+	auto window_begin = [&](const uint32_t tile) { return (uint32_t) std::max<int64_t>(0, (int64_t) tile * tile_size * m_downscale + half - reach); };
+	auto window_end = [&](const uint32_t tile, const uint32_t out_size, const uint32_t in_size) {
+		const int64_t last = (int64_t) (std::min<uint32_t>(out_size, (tile + 1) * tile_size) - 1) * m_downscale + half;
+		return (uint32_t) std::min<int64_t>(in_size, last + reach + 1);
+	};
+
+	pool().parallel_for(0, tiles_y, [&](const uint32_t begin, const uint32_t end) {
+		for(uint32_t ty = begin; ty < end; ++ty) {
+			const uint32_t y_begin = window_begin(ty);
+			const uint32_t y_end = window_end(ty, out_height, mask.height());
+			for(uint32_t tx = 0; tx < tiles_x; ++tx) {
+				const uint32_t x_begin = window_begin(tx);
+				const uint32_t x_end = window_end(tx, out_width, mask.width());
+				const uint32_t count = sums.count(x_begin, y_begin, x_end, y_end);
+
+				if(count == 0) tiles[(size_t) ty * tiles_x + tx] = tile_outside;
+				else if(count == (uint64_t) (x_end - x_begin) * (y_end - y_begin)) tiles[(size_t) ty * tiles_x + tx] = tile_inside;
+			}
+		}
+	});
+}
+
+void sdf_generator::generate_brute_force(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	std::vector<tile_class> tiles;
+	classify_tiles(mask, out_width, out_height, tiles);
+
+	// The common configurations get a search specialized at compile time:
+	if(generate_brute_force_fixed(mask, tiles, out_pixels, out_width, out_height)) return;
+
+	scan_windows(mask, tiles, out_pixels, out_width, out_height, [this](const bitmap& source, const uint32_t center_x, const uint32_t center_y, int32_t * row_distances) {
+		return find_signed_square(center_x, center_y, source, row_distances);
+	});
+}
+
+bool sdf_generator::generate_brute_force_fixed(const bitmap& mask, const std::vector<tile_class>& tiles, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	switch((int32_t) ceil(m_spread)) {
+	case 8: generate_brute_force_window<8>(mask, tiles, out_pixels, out_width, out_height); return true;
+	case 16: generate_brute_force_window<16>(mask, tiles, out_pixels, out_width, out_height); return true;
+	case 32: generate_brute_force_window<32>(mask, tiles, out_pixels, out_width, out_height); return true;
+	case 64: generate_brute_force_window<64>(mask, tiles, out_pixels, out_width, out_height); return true;
+	default: return false;
+	}
+}
+
+template<int32_t Delta>
+void sdf_generator::generate_brute_force_window(const bitmap& mask, const std::vector<tile_class>& tiles, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	typedef window_search<Delta> search;
+
+	scan_windows(mask, tiles, out_pixels, out_width, out_height, [this](const bitmap& source, const uint32_t center_x, const uint32_t center_y, int32_t * row_distances) {
+		// Windows cut off by the border take the generic search:
+		if(!search::contains(source, center_x, center_y)) {
+			return find_signed_square(center_x, center_y, source, row_distances);
+		}
+
+		const bool base = source.get(center_x, center_y);
+		return signed_square(search::find_square_distance(source, center_x, center_y, base), base);
+	});
+}
+
+template<typename Search>
+void sdf_generator::scan_windows(const bitmap& mask, const std::vector<tile_class>& tiles, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height, const Search& search)
+{
+	const int32_t delta = (int32_t) ceil(m_spread);
+	const uint32_t tiles_x = (out_width + tile_size - 1) / tile_size;
+	const size_t pixel_bytes = image::bytes_per_pixel(m_format);
+
+	// Without blocking, every output row is a block of its own that searches the whole mask:
+	const uint32_t block = window_block_size(mask);
+	const uint32_t block_width = block ? block : out_width;
+	const uint32_t block_height = block ? block : 1;
+	const uint32_t blocks_x = (out_width + block_width - 1) / block_width;
+	const uint32_t blocks_y = (out_height + block_height - 1) / block_height;
+
+	pool().parallel_for(0, blocks_x * blocks_y, [&](const uint32_t begin, const uint32_t end) {
+		std::vector<int32_t> row_distances(2 * delta + 1);
+		std::vector<int32_t> signed_squares(block_width);
+		std::vector<float> signed_distances(block_width);
+		bitmap halo;
+
+		for(uint32_t i = begin; i < end; ++i) {
+			const uint32_t out_left = (i % blocks_x) * block_width;
+			const uint32_t out_top = (i / blocks_x) * block_height;
+			const uint32_t out_right = std::min(out_left + block_width, out_width);
+			const uint32_t out_bottom = std::min(out_top + block_height, out_height);
+
+			// With blocking, search a copy of just the mask pixels the windows of the block reach.
+			// It only cuts off windows where the mask does, so every search finds the same pixel:
+			uint32_t left = 0;
+			uint32_t top = 0;
+			if(block) {
+				left = (uint32_t) std::max<int32_t>(0, (int32_t) (out_left * m_downscale + m_downscale / 2) - delta);
+				top = (uint32_t) std::max<int32_t>(0, (int32_t) (out_top * m_downscale + m_downscale / 2) - delta);
+				const uint32_t right = std::min<uint32_t>(mask.width(), (out_right - 1) * m_downscale + m_downscale / 2 + delta + 1);
+				const uint32_t bottom = std::min<uint32_t>(mask.height(), (out_bottom - 1) * m_downscale + m_downscale / 2 + delta + 1);
+				halo = mask.region(left, top, right - left, bottom - top);
+			}
+			const bitmap& source = block ? halo : mask;
+
+			for(uint32_t y = out_top; y < out_bottom; ++y) {
+				const tile_class * tile_row = &tiles[(size_t) (y / tile_size) * tiles_x];
+				const uint32_t center_y = (y * m_downscale) + (m_downscale / 2) - top;
+				for(uint32_t x = out_left; x < out_right; ++x) {
+					const tile_class tile = tile_row[x / tile_size];
+					if(tile != tile_mixed) {
+						signed_squares[x - out_left] = signed_square(delta * delta, tile == tile_inside);
+						continue;
+					}
+
+					signed_squares[x - out_left] = search(source, (x * m_downscale) + (m_downscale / 2) - left, center_y, row_distances.data());
+				}
+				encode_square_row(signed_squares.data(), signed_distances.data(), out_right - out_left, out_pixels + ((size_t) y * out_width + out_left) * pixel_bytes, 0);
+			}
+		}
+	});
+}
+
+uint32_t sdf_generator::window_block_size(const bitmap& mask) const
+{
+	if(!m_cache_blocking) return 0;
+
+	// Row by row, the windows of an output row reach 2 * delta + 1 whole rows of the mask, which is fine while those fit:
+	const uint64_t window = 2 * (uint64_t) ceil(m_spread) + 1;
+	if(window * mask.stride() * sizeof(uint64_t) <= cache_block_bytes) return 0;
+
+	// Otherwise take the largest square block, in whole tiles, whose halo of about side * side / 8 bytes fits:
+	const uint64_t side = (uint64_t) sqrt(cache_block_bytes * 8.0);
+	if(side < window + (uint64_t) tile_size * m_downscale) return 0;
+	return (uint32_t) ((side - window) / m_downscale / tile_size * tile_size);
+}
+
+void sdf_generator::generate_edt(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	if(out_width == 0 || out_height == 0) return;
+
+	const uint32_t in_width = mask.width();
+
+	// Distances of ceil(spread) or more all end up as the same saturated value, so that is as far as we need to look:
+	const int32_t limit = (int32_t) ceil(m_spread);
+	const int32_t half = (int32_t) m_downscale / 2;
+	std::vector<int32_t> to_outside((size_t) out_height * in_width);
+	std::vector<int32_t> to_inside((size_t) out_height * in_width);
+
+	// Only the rows holding a sampled output pixel need the second pass. Columns are independent
+	// in the first pass and rows are independent in the second:
+	pool().parallel_for(0, in_width, [&](const uint32_t begin, const uint32_t end) {
+		distance_transform::column_pass(
+			mask,
+			(int32_t) begin, (int32_t) end,
+			half, (int32_t) m_downscale, (int32_t) out_height,
+			limit, to_outside.data(), to_inside.data()
+		);
+	});
+
+	pool().parallel_for(0, out_height, [&](const uint32_t begin, const uint32_t end) {
+		distance_transform transform;
+		std::vector<int32_t> outside_row(in_width), inside_row(in_width);
+		std::vector<int32_t> signed_squares(out_width);
+		std::vector<float> signed_distances(out_width);
+
+		for(uint32_t y = begin; y < end; ++y) {
+			transform.row_pass(&to_outside[(size_t) y * in_width], (int32_t) in_width, limit, outside_row.data());
+			transform.row_pass(&to_inside[(size_t) y * in_width], (int32_t) in_width, limit, inside_row.data());
+
+			const uint32_t center_y = y * m_downscale + half;
+			for(uint32_t x = 0; x < out_width; ++x) {
+				const uint32_t center_x = x * m_downscale + half;
+				const bool inside = mask.get(center_x, center_y);
+				const int square_distance = inside ? outside_row[center_x] : inside_row[center_x];
+				signed_squares[x] = signed_square(square_distance, inside);
+			}
+			encode_square_row(signed_squares.data(), signed_distances.data(), out_width, out_pixels, y);
+		}
+	});
+}
+
+void sdf_generator::generate_spiral(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	const std::vector<offset>& offsets = sorted_offsets();
+	std::vector<tile_class> tiles;
+	classify_tiles(mask, out_width, out_height, tiles);
+
+	scan_windows(mask, tiles, out_pixels, out_width, out_height, [this, &offsets](const bitmap& source, const uint32_t center_x, const uint32_t center_y, int32_t *) {
+		return find_signed_square_spiral(center_x, center_y, source, offsets);
+	});
+}
+
+void sdf_generator::generate_dead_reckoning(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	const uint32_t in_width = mask.width();
+	const int32_t delta = (int32_t) ceil(m_spread);
+	const int64_t limit = (int64_t) delta * delta;
+	std::vector<uint32_t> nearest;
+
+	// The sweeps depend on the rows before them, so only the sampling afterwards is split across threads:
+	dead_reckoning::find_nearest(mask, nearest);
+
+	pool().parallel_for(0, out_height, [&](const uint32_t begin, const uint32_t end) {
+		std::vector<int32_t> signed_squares(out_width);
+		std::vector<float> signed_distances(out_width);
+
+		for(uint32_t y = begin; y < end; ++y) {
+			const uint32_t center_y = (y * m_downscale) + (m_downscale / 2);
+			for(uint32_t x = 0; x < out_width; ++x) {
+				const uint32_t center_x = (x * m_downscale) + (m_downscale / 2);
+				const uint32_t closest = nearest[(size_t) center_y * in_width + center_x];
+				const int64_t square_distance = closest == dead_reckoning::none ? limit : std::min<int64_t>(limit, dead_reckoning::square_distance(center_x, center_y, closest, in_width));
+				signed_squares[x] = signed_square((int32_t) square_distance, mask.get(center_x, center_y));
+			}
+			encode_square_row(signed_squares.data(), signed_distances.data(), out_width, out_pixels, y);
+		}
+	});
+}
+
+void sdf_generator::generate_jump_flood(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	const int32_t delta = (int32_t) ceil(m_spread);
+	const int64_t limit = (int64_t) delta * delta;
+	const uint32_t in_width = mask.width();
+	std::vector<jump_flood::seed> seeds;
+
+	jump_flood::find_nearest(mask, (uint32_t) delta, pool(), seeds);
+
+	pool().parallel_for(0, out_height, [&](const uint32_t begin, const uint32_t end) {
+		std::vector<int32_t> signed_squares(out_width);
+		std::vector<float> signed_distances(out_width);
+
+		for(uint32_t y = begin; y < end; ++y) {
+			const uint32_t center_y = (y * m_downscale) + (m_downscale / 2);
+			for(uint32_t x = 0; x < out_width; ++x) {
+				const uint32_t center_x = (x * m_downscale) + (m_downscale / 2);
+				const jump_flood::seed closest = seeds[(size_t) center_y * in_width + center_x];
+				const int64_t square_distance = jump_flood::is_none(closest) ? limit : std::min<int64_t>(limit, jump_flood::square_distance(center_x, center_y, closest));
+				signed_squares[x] = signed_square((int32_t) square_distance, mask.get(center_x, center_y));
+			}
+			encode_square_row(signed_squares.data(), signed_distances.data(), out_width, out_pixels, y);
+		}
+	});
+}
+
+void sdf_generator::generate_edge_grid(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	const uint32_t delta = (uint32_t) ceil(m_spread);
+	edge_grid grids[2];
+
+	// Inside pixels look for the closest "outside" edge pixel and vice versa:
+	pool().parallel_for(0, 2, [&](const uint32_t begin, const uint32_t end) {
+		for(uint32_t i = begin; i < end; ++i) {
+			grids[i].build(mask, i != 0, delta);
+		}
+	});
+
+	pool().parallel_for(0, out_height, [&](const uint32_t begin, const uint32_t end) {
+		std::vector<int32_t> signed_squares(out_width);
+		std::vector<float> signed_distances(out_width);
+
+		for(uint32_t y = begin; y < end; ++y) {
+			const uint32_t center_y = (y * m_downscale) + (m_downscale / 2);
+			for(uint32_t x = 0; x < out_width; ++x) {
+				const uint32_t center_x = (x * m_downscale) + (m_downscale / 2);
+				const bool inside = mask.get(center_x, center_y);
+				const int64_t square_distance = grids[inside ? 0 : 1].closest_square_distance(center_x, center_y, delta);
+				signed_squares[x] = signed_square((int32_t) square_distance, inside);
+			}
+			encode_square_row(signed_squares.data(), signed_distances.data(), out_width, out_pixels, y);
+		}
+	});
+}
+
+void sdf_generator::generate_coverage(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	const float block_area = (float) m_downscale * m_downscale;
+	std::vector<float> coverage((size_t) out_width * out_height);
+
+	pool().parallel_for(0, out_height, [&](const uint32_t begin, const uint32_t end) {
+		for(uint32_t y = begin; y < end; ++y) {
+			for(uint32_t x = 0; x < out_width; ++x) {
+				uint32_t inside = 0;
+				for(uint32_t row = y * m_downscale; row < (y + 1) * m_downscale; ++row) {
+					inside += mask.count_in_row(row, x * m_downscale, (x + 1) * m_downscale);
+				}
+				coverage[(size_t) y * out_width + x] = (float) inside / block_area;
+			}
+		}
+	});
+
+	generate_antialiased(coverage, out_pixels, out_width, out_height);
+}
+
+void sdf_generator::generate_grayscale(const image& input_image, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	const uint32_t in_width = input_image.width();
+	const uint32_t * in_pixels = (const uint32_t*) input_image.pixels();
+	const float block_area = (float) m_downscale * m_downscale;
+	std::vector<float> coverage((size_t) out_width * out_height);
+
+	pool().parallel_for(0, out_height, [&](const uint32_t begin, const uint32_t end) {
+		for(uint32_t y = begin; y < end; ++y) {
+			for(uint32_t x = 0; x < out_width; ++x) {
+				float sum = 0.0f;
+				for(uint32_t row = y * m_downscale; row < (y + 1) * m_downscale; ++row) {
+					const uint32_t * in_row = in_pixels + (size_t) row * in_width;
+					for(uint32_t column = x * m_downscale; column < (x + 1) * m_downscale; ++column) {
+						sum += coverage_of(in_row[column]);
+					}
+				}
+				coverage[(size_t) y * out_width + x] = sum / block_area;
+			}
+		}
+	});
+
+	generate_antialiased(coverage, out_pixels, out_width, out_height);
+}
+
+void sdf_generator::generate_antialiased(const std::vector<float>& coverage, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height)
+{
+	const size_t count = coverage.size();
+	std::vector<float> inverse(count);
+	std::vector<float> distances[2] = { std::vector<float>(count), std::vector<float>(count) };
+
+	// One transform measures from the outside and one, on the inverse, from the inside:
+	for(size_t i = 0; i < count; ++i) {
+		inverse[i] = 1.0f - coverage[i];
+	}
+	const float * sources[2] = { coverage.data(), inverse.data() };
+
+	// The sweeps depend on each other, but the two transforms do not. Anything a pixel past the spread
+	// saturates, so there is no need to propagate further than that:
+	const float limit = m_spread / m_downscale + 1.0f;
+	pool().parallel_for(0, 2, [&](const uint32_t begin, const uint32_t end) {
+		antialiased_edt transform;
+		for(uint32_t i = begin; i < end; ++i) {
+			transform.transform(sources[i], out_width, out_height, limit, distances[i].data());
+		}
+	});
+
+	pool().parallel_for(0, out_height, [&](const uint32_t begin, const uint32_t end) {
+		std::vector<float> signed_distances(out_width);
+
+		for(uint32_t y = begin; y < end; ++y) {
+			for(uint32_t x = 0; x < out_width; ++x) {
+				const size_t index = (size_t) y * out_width + x;
+				const float to_inside = std::max<float>(0.0f, distances[0][index]);
+				const float to_outside = std::max<float>(0.0f, distances[1][index]);
+
+				// Distances are in output pixels, the spread is in input pixels:
+				const float signed_distance = (to_outside - to_inside) * m_downscale;
+				signed_distances[x] = std::min<float>(m_spread, std::max<float>(-m_spread, signed_distance));
+			}
+			encode_row(signed_distances.data(), out_width, out_pixels, y);
+		}
+	});
+}
+
+const std::vector<sdf_generator::offset>& sdf_generator::sorted_offsets()
+{
+	const int32_t delta = (int32_t) ceil(m_spread);
+	if(delta == m_offsets_delta) return m_offsets;
+
+	// Anything at ceil(spread) or further saturates, the same as finding nothing at all:
+	const int32_t limit = delta * delta;
+	m_offsets.clear();
+	for(int32_t dy = -delta + 1; dy < delta; ++dy) {
+		for(int32_t dx = -delta + 1; dx < delta; ++dx) {
+			const int32_t square_distance = dx * dx + dy * dy;
+			if(square_distance > 0 && square_distance < limit) {
+				m_offsets.push_back({ dx, dy, square_distance });
+			}
+		}
+	}
+
+	std::stable_sort(m_offsets.begin(), m_offsets.end(), [](const offset& a, const offset& b) {
+		return a.square_distance < b.square_distance;
+	});
+
+	m_offsets_delta = delta;
+	return m_offsets;
+}
+
+thread_pool& sdf_generator::pool()
+{
+	if(!m_pool) m_pool = std::make_shared<thread_pool>(m_threads);
+	return *m_pool;
+}
+
+const char * sdf_generator::algorithm_name(const algorithm value)
+{
+	switch(value) {
+	case algorithm::edt: return "edt";
+	case algorithm::spiral: return "spiral";
+	case algorithm::dead_reckoning: return "dead_reckoning";
+	case algorithm::jump_flood: return "jump_flood";
+	case algorithm::edge_grid: return "edge_grid";
+	case algorithm::coverage: return "coverage";
+	case algorithm::grayscale: return "grayscale";
+	case algorithm::brute_force:
+	default: return "brute_force";
+	}
+}
+
+bool sdf_generator::parse_algorithm(const std::string& name, algorithm& value)
+{
+	static const algorithm all[] = { algorithm::brute_force, algorithm::edt, algorithm::spiral, algorithm::dead_reckoning, algorithm::jump_flood, algorithm::edge_grid, algorithm::coverage, algorithm::grayscale };
+	for(const algorithm candidate : all) {
+		if(name == algorithm_name(candidate)) {
+			value = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
 uint32_t sdf_generator::distance_to_rgb(const float signed_distance)
 {
 	float alpha = 0.5f + 0.5f * (signed_distance / m_spread);
@@ -63,22 +1151,32 @@ uint32_t sdf_generator::distance_to_rgb(const float signed_distance)
 	return (alpha_byte << 24) | (m_color & 0xFFFFFF);
 }
 
-float sdf_generator::find_signed_distance(const int center_x, const int center_y, const bool * bitmap, const int width, const int height)
+int32_t sdf_generator::find_signed_square(const int center_x, const int center_y, const bitmap& mask, int32_t * row_distances)
 {
-	bool base = bitmap[center_y * width + center_x];
+	const int width = (int) mask.width();
+	const int height = (int) mask.height();
+	bool base = mask.get(center_x, center_y);
 
 	int delta = (int) ceil(m_spread);
 	int start_x = std::max<int>(0, center_x - delta);
 	int end_x = std::min<int>(width - 1, center_x + delta);
 	int start_y = std::max<int>(0, center_y - delta);
 	int end_y = std::min<int>(height - 1, center_y + delta);
-	int sqrt_distance = 0;
 	int closest_sqrt_distance = delta * delta;
 
+	// Only the closest pixel of the other color in each row can be the closest one overall:
 	for(int y = start_y; y <= end_y; ++y) {
-		for(int x = start_x; x <= end_x; ++x) {
-			if(base != bitmap[y * width + x]) {
-				sqrt_distance = square_distance(center_x, center_y, x, y);
+		row_distances[y - start_y] = mask.find_nearest_in_row(y, center_x, start_x, end_x, base);
+	}
+
+	if(delta < 32768) {
+		closest_sqrt_distance = m_kernels->min_square_distance(row_distances, end_y - start_y + 1, start_y - center_y, closest_sqrt_distance);
+	}
+	else {
+		for(int y = start_y; y <= end_y; ++y) {
+			const int dx = row_distances[y - start_y];
+			if(dx >= 0) {
+				const int sqrt_distance = square_distance(center_x, center_y, center_x + dx, y);
 				if(sqrt_distance < closest_sqrt_distance) {
 					closest_sqrt_distance = sqrt_distance;
 				}
@@ -86,14 +1184,64 @@ float sdf_generator::find_signed_distance(const int center_x, const int center_y
 		}
 	}
 
-	float closest_distance = (float) sqrt(closest_sqrt_distance);
-	return (base ? 1 : -1) * std::min<float>(closest_distance, m_spread);
+	return signed_square(closest_sqrt_distance, base);
+}
+
+int32_t sdf_generator::find_signed_square_spiral(const int center_x, const int center_y, const bitmap& mask, const std::vector<offset>& offsets) const
+{
+	const bool base = mask.get(center_x, center_y);
+	const int delta = (int) ceil(m_spread);
+	const offset * closest = find_nearest_spiral(center_x, center_y, mask, offsets);
+	return signed_square(closest ? closest->square_distance : delta * delta, base);
+}
+
+const sdf_generator::offset * sdf_generator::find_nearest_spiral(const int center_x, const int center_y, const bitmap& mask, const std::vector<offset>& offsets) const
+{
+	const int width = (int) mask.width();
+	const int height = (int) mask.height();
+	const bool base = mask.get(center_x, center_y);
+
+	for(const offset& o : offsets) {
+		const int x = center_x + o.dx;
+		const int y = center_y + o.dy;
+		if(x >= 0 && y >= 0 && x < width && y < height && mask.get(x, y) != base) {
+			return &o;
+		}
+	}
+
+	return nullptr;
+}
+
+int sdf_generator::find_nearest_label(const int center_x, const int center_y, const image& input_image, const bitmap& border, const offset_iterator first, const offset_iterator last, uint32_t& color) const
+{
+	const int width = (int) input_image.width();
+	const int height = (int) input_image.height();
+	const uint32_t * in_pixels = (const uint32_t *) input_image.pixels();
+	const uint32_t base = in_pixels[(size_t) center_y * width + center_x];
+	const int delta = (int) ceil(m_spread);
+
+	for(offset_iterator o = first; o != last; ++o) {
+		const int x = center_x + o->dx;
+		const int y = center_y + o->dy;
+		if(x >= 0 && y >= 0 && x < width && y < height && border.get(x, y) && in_pixels[(size_t) y * width + x] != base) {
+			color = in_pixels[(size_t) y * width + x];
+			return o->square_distance;
+		}
+	}
+
+	return delta * delta;
+}
+
+float sdf_generator::to_signed_distance(const int square_distance, const bool inside) const
+{
+	float closest_distance = (float) sqrt(square_distance);
+	return (inside ? 1 : -1) * std::min<float>(closest_distance, m_spread);
 }
 
 bool sdfgen::sdf_generate_export(
 	const uint8_t * input_buffer, const uint32_t input_width, const uint32_t input_height,
 	const int32_t downscale, const float spread,
-	uint8_t * output_buffer)
+	uint8_t * output_buffer, const uint32_t threads)
 {
 	// CHECKS:
 	if(!input_buffer || !output_buffer) return false;
@@ -103,6 +1251,7 @@ bool sdfgen::sdf_generate_export(
 
 	// GENERATE SIGNED DISTANCE FIELD:
 	sdf_generator gen(sdf_generator::default_color, spread, downscale);
+	gen.set_threads(threads);
 	sdfgen::image_ptr out_image = gen.generate(in_image);
 	if(out_image == nullptr) return false;
 
@@ -111,4 +1260,48 @@ bool sdfgen::sdf_generate_export(
 
 	// SUCCESS:
 	return true;
+}
+
+bool sdfgen::sdf_generate_r8_export(
+	const uint8_t * input_buffer, const uint32_t input_width, const uint32_t input_height,
+	const int32_t downscale, const float spread,
+	uint8_t * output_buffer, const uint32_t threads)
+{
+	// CHECKS:
+	if(!input_buffer || !output_buffer) return false;
+
+	// CREATE INPUT IMAGE:
+	sdfgen::image_ptr in_image = std::make_shared<sdfgen::image>((sdfgen::byte_ptr) input_buffer, input_width, input_height);
+
+	// GENERATE SIGNED DISTANCE FIELD, ALPHA ONLY:
+	sdf_generator gen(sdf_generator::default_color, spread, downscale);
+	gen.set_threads(threads);
+	gen.set_format(image::pixel_format::r8);
+	sdfgen::image_ptr out_image = gen.generate(in_image);
+	if(out_image == nullptr) return false;
+
+	// COPY OUTPUT IMAGE INTO OUTPUT BUFFER:
+	std::memcpy(output_buffer, out_image->pixels(), out_image->length());
+
+	// SUCCESS:
+	return true;
+}
+
+bool sdfgen::sdf_generate_stream_export(
+	const uint32_t input_width, const uint32_t input_height,
+	const int32_t downscale, const float spread,
+	sdf_read_row_callback read_row, sdf_write_row_callback write_row, void * user_data,
+	const uint32_t threads)
+{
+	// CHECKS:
+	if(!read_row || !write_row) return false;
+
+	// GENERATE SIGNED DISTANCE FIELD, A BAND OF ROWS AT A TIME:
+	sdf_generator gen(sdf_generator::default_color, spread, downscale);
+	gen.set_threads(threads);
+	return gen.generate_stream(
+		input_width, input_height,
+		[&](const uint32_t y, uint32_t * pixels) { return read_row(y, (uint8_t *) pixels, user_data); },
+		[&](const uint32_t y, const byte * pixels) { return write_row(y, pixels, user_data); }
+	);
 }
\ No newline at end of file
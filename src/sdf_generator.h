@@ -1,19 +1,143 @@
 #pragma once
 #include "color.h"
 #include "image.h"
+#include "tiled_image.h"
+#include "bitmap.h"
+#include "thread_pool.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <functional>
 
 namespace sdfgen {
 
 	class sdf_generator {
+	public:
+		/**
+		* The method used to find the distance from each pixel to the closest pixel of the opposite color.
+		*
+		* <p> {@code brute_force} scans a square window of {@link #spread} pixels around every output pixel.
+		* {@code edt} runs an exact Euclidean distance transform over the whole image, its cost does not
+		* depend on the spread. {@code spiral} visits the pixels within {@link #spread} in order of
+		* increasing distance and stops at the first one of the opposite color, which is fast near edges.
+		* All of them produce identical output.
+		*
+		* <p> {@code dead_reckoning} propagates the closest pixel of the opposite color in two sweeps over
+		* the image. Most pixels come out exact, but the two sweeps can miss the true closest pixel behind
+		* concave edges, and the error is not bounded by a fixed fraction of a pixel: at a spread of 32 it
+		* reaches about 2.3 pixels in the worst case. It runs in linear time, which suits interactive tools
+		* that regenerate constantly.
+		*
+		* <p> {@code jump_flood} approximates the distances in {@code log2(spread) + 1} fully parallel passes,
+		* trading a small, bounded error for speed on very large images.
+		*
+		* <p> {@code edge_grid} extracts the edge pixels first and only measures the distance to those in
+		* the grid cells around each pixel. It is exact and fast on line art and fonts, where edges are
+		* a small part of the image.
+		*
+		* <p> {@code coverage} first reduces every {@link #downscale} by {@link #downscale} block of the input
+		* to the fraction of it that is "inside", then runs an anti-aliased distance transform on those
+		* values at output resolution. The edge is placed with sub-pixel accuracy from the coverage, so the
+		* result is comparable to the other algorithms at about {@code 1 / downscale^2} of the cost.
+		*
+		* <p> {@code grayscale} works like {@code coverage}, but takes the coverage from the pixel values
+		* themselves, see {@link #coverage_of}, instead of thresholding them first. Anti-aliased inputs keep
+		* their sub-pixel edges, so they give smooth fields at their native resolution.
+		*
+		* <p> {@code dead_reckoning}, {@code jump_flood}, {@code coverage} and {@code grayscale} are approximate,
+		* the others are exact.
+		*/
+		enum class algorithm { brute_force, edt, spiral, dead_reckoning, jump_flood, edge_grid, coverage, grayscale };
+
+		/**
+		* Fills {@code pixels} with input row {@code y} for {@link #generate_stream}.
+		* Returns {@code false} to stop generating.
+		*/
+		typedef std::function<bool(const uint32_t y, uint32_t * pixels)> row_source;
+
+		/**
+		* Receives output row {@code y} from {@link #generate_stream} in the selected {@link #format},
+		* valid only during the call. Returns {@code false} to stop generating.
+		*/
+		typedef std::function<bool(const uint32_t y, const byte * pixels)> row_sink;
+
+		/** A rectangle of pixels. */
+		struct rectangle {
+			uint32_t x;
+			uint32_t y;
+			uint32_t width;
+			uint32_t height;
+		};
+
+		/** A position relative to the center of a search, along with its squared distance from that center. */
+		struct offset {
+			int32_t dx;
+			int32_t dy;
+			int32_t square_distance;
+		};
+
+		/**
+		* Where the closest pixel of the opposite color is, in input pixels from the pixel an output pixel
+		* was sampled at, see {@link #generate_nearest}. Both are zero when there is none within the spread,
+		* since a pixel is never the opposite color of itself.
+		*/
+		struct feature_offset {
+			int16_t dx;
+			int16_t dy;
+		};
+
+		/** One spread and downscale to generate from the same input, see {@link #generate_variants}. */
+		struct variant {
+			float spread;
+			int32_t downscale;
+		};
+
+		/** The result of {@link #generate_labels}. */
+		struct label_field {
+			/** The distance from every output pixel to the closest pixel of another label, in the selected {@link #format}. */
+			image_ptr distances;
+
+			/** For every output pixel, row by row, the label of that closest pixel, or {@link #no_label} if none is within the spread. */
+			std::vector<uint32_t> nearest_labels;
+
+			/** The color of every label, numbered in the order they first appear in the input, row by row. */
+			std::vector<uint32_t> colors;
+		};
+
 	private:
 		uint32_t m_color;
 		float m_spread;
 		uint32_t m_downscale;
+		algorithm m_algorithm;
+		uint32_t m_threads;
+		image::pixel_format m_format;
+		bool m_lookup;
+		bool m_cache_blocking;
+		thread_pool_ptr m_pool;
+		const simd_kernels * m_kernels;
+		bitmap m_mask;
+		std::vector<offset> m_offsets;
+		int32_t m_offsets_delta;
+		std::vector<byte> m_lookup_table;
+		float m_lookup_spread;
+		uint32_t m_lookup_color;
+		image::pixel_format m_lookup_format;
 
 	public:
 		static constexpr uint32_t default_color = 0xFFFFFFFF;
 		static constexpr float default_spread = 32;
 		static constexpr int32_t default_downscale = 1;
+		static constexpr algorithm default_algorithm = algorithm::brute_force;
+		static constexpr uint32_t default_threads = 1;
+		/** The largest {@code ceil(spread)} the encoding table of {@link #set_lookup} is used up to, {@code 2 * 1024^2 + 2} four-byte entries or about 8 MB for rgba8. */
+		static constexpr int32_t max_lookup_delta = 1024;
+		/** Marks output pixels without another label within the spread, see {@link #generate_labels}. */
+		static constexpr uint32_t no_label = 0xFFFFFFFF;
+		/** The width and height in output pixels of the tiles checked by {@link #classify_tiles}. */
+		static constexpr uint32_t tile_size = 16;
+		/** The bytes of mask the windows of one block of output pixels may reach, half of a typical L2 cache, see {@link #set_cache_blocking}. */
+		static constexpr uint32_t cache_block_bytes = 128 * 1024;
 
 		sdf_generator(const uint32_t color = default_color, const float spread = default_spread, const int32_t downscale = default_downscale);
 		~sdf_generator();
@@ -55,6 +179,92 @@ namespace sdfgen {
 		*/
 		float set_spread(const float spread) { const float old = spread; m_spread = spread; return old; }
 
+		/** @see #set_algorithm(algorithm) */
+		algorithm get_algorithm() const { return m_algorithm; }
+
+		/**
+		* Sets the algorithm used to compute the distances. Defaults to {@code algorithm::brute_force}.
+		*
+		* @see algorithm
+		*/
+		algorithm set_algorithm(const algorithm value) { const algorithm old = m_algorithm; m_algorithm = value; return old; }
+
+		/** Returns the name of an algorithm as accepted by {@link #parse_algorithm}. */
+		static const char * algorithm_name(const algorithm value);
+
+		/**
+		* Looks up an algorithm by name, such as "brute_force" or "edt".
+		*
+		* @return {@code false} if there is no algorithm by that name
+		*/
+		static bool parse_algorithm(const std::string& name, algorithm& value);
+
+		/** @see #set_threads(uint32_t) */
+		uint32_t get_threads() const { return m_threads; }
+
+		/**
+		* Sets the number of threads used to generate a distance field, including the calling thread.
+		* Zero uses one thread per hardware thread. Defaults to a single thread.
+		*
+		* <p> The threads are started on the next call to {@link #generate} and kept around for later calls.
+		*/
+		uint32_t set_threads(const uint32_t threads) { const uint32_t old = m_threads; if(threads != old) m_pool = nullptr; m_threads = threads; return old; }
+
+		/** @see #set_format(image::pixel_format) */
+		image::pixel_format get_format() const { return m_format; }
+
+		/**
+		* Sets the pixel format of the generated fields. Defaults to {@code rgba8}, the signed distance
+		* normalized by the spread into the alpha channel.
+		*
+		* <p> {@code r8} holds only that alpha channel, a quarter of the memory for the same field,
+		* since the color channels would just repeat {@link #color} on every pixel.
+		*
+		* <p> {@code r32f} and {@code r16f} store the signed distance itself in output pixels, positive
+		* inside, limited to the spread like every algorithm limits it. They can be filtered or combined
+		* before they are quantized, see {@link #encode}. {@code r16f} is exact to about 1/2048 of the
+		* distance, so it keeps at least 1/64 pixel of precision up to a spread of 32.
+		*/
+		image::pixel_format set_format(const image::pixel_format format) { const image::pixel_format old = m_format; m_format = format; return old; }
+
+		/** @see #set_lookup(bool) */
+		bool get_lookup() const { return m_lookup; }
+
+		/**
+		* Sets whether the algorithms that find integer squared distances encode them through a table,
+		* instead of taking a square root, normalizing, clamping and converting every pixel in floating point.
+		* There are only {@code ceil(spread)^2 + 1} possible squared distances on either side of the edge,
+		* so the table is built once per spread, color and format, and gives the same pixels as the float
+		* path. Defaults to {@code true}, and is never used beyond {@link #max_lookup_delta}.
+		*
+		* <p> {@code coverage} and {@code grayscale} have fractional distances and always use the float path.
+		*/
+		bool set_lookup(const bool lookup) { const bool old = m_lookup; m_lookup = lookup; return old; }
+
+		/** @see #set_cache_blocking(bool) */
+		bool get_cache_blocking() const { return m_cache_blocking; }
+
+		/**
+		* Sets whether {@code brute_force} and {@code spiral} go through the output in square blocks instead
+		* of row by row once the windows of an output row reach more than {@link #cache_block_bytes} of the
+		* mask, as they do for wide images and large spreads. Each block searches its own copy of the mask
+		* pixels its windows reach, which stays in the cache for the whole block. The output is the same
+		* either way. Defaults to {@code true}.
+		*/
+		bool set_cache_blocking(const bool cache_blocking) { const bool old = m_cache_blocking; m_cache_blocking = cache_blocking; return old; }
+
+		/**
+		* Encodes a field generated as {@code r32f} or {@code r16f} into {@code rgba8}, with the current
+		* color and spread, the same way {@link #generate} would have. The distances were limited to the
+		* spread they were generated with, so a larger spread here does not bring back what was cut off:
+		* generate with the largest spread needed, then encode with any spread up to it.
+		*
+		* <p> An {@code r8} field is expanded to {@code rgba8} with the current color, keeping its alpha.
+		*
+		* @throws std::exception if {@code distance_field} is already {@code rgba8}
+		*/
+		image_ptr encode(const image& distance_field);
+
 		/**
 		* Process the image into a distance field.
 		*
@@ -72,7 +282,134 @@ namespace sdfgen {
 		image_ptr generate(const image_ptr& input_image) { return generate(*input_image); }
 		image_ptr generate(const image& input_image);
 
+		/**
+		* Same as {@link #generate} for the image in {@code file}, but without ever holding it as {@code rgba8}.
+		* The file is decoded with its own number of channels, gray, gray and alpha, RGB or RGBA, and
+		* thresholded straight into the mask, which saves the copy into an {@link image} and three bytes
+		* per pixel for gray files. {@code grayscale} needs the pixel values and loads the whole image.
+		*
+		* @throws std::exception if the file cannot be decoded
+		*/
+		image_ptr generate_file(const std::string& file);
+
+		/**
+		* Generates the fields of up to four images of the same size, each into one channel of
+		* a single {@code rgba8} image: the first into red, then green, blue and alpha. Channels without
+		* an input are left at zero. Each channel holds what the alpha channel of {@link #generate} would,
+		* so several layers of the same artwork, such as a shape, its outline and its shadow, take up one
+		* texture instead of four.
+		*
+		* <p> This is not a single pass: each input is thresholded and generated in turn, one after the
+		* other, and only the mask and output buffers are shared between them. It costs about as much as
+		* one {@link #generate} per input, without the intermediate images and the packing afterwards.
+		* The kept mask of {@link #regenerate} is not touched.
+		*
+		* @throws std::exception if there are no inputs or more than four, or if their sizes differ
+		*/
+		image_ptr generate_packed(const std::vector<image_ptr>& input_images);
+
+		/**
+		* Generates the distance fields of every region of a label map at once, such as the provinces of a map.
+		* Every distinct color of {@code input_image} is a label, and every output pixel gets the distance to
+		* the closest input pixel of any other label, which is the border of its own region, together with
+		* that other label. The distances are positive, as inside the field of {@link #generate}, and are
+		* limited to the spread the same way. The kept mask of {@link #regenerate} is not touched.
+		*
+		* <p> Pixels are found by walking outwards like {@code algorithm::spiral}, whatever the algorithm is
+		* set to, starting at the distance to the closest border pixel of any region as found by an exact
+		* distance transform. Only the last ring or so is walked, so the cost barely depends on the spread.
+		*/
+		label_field generate_labels(const image& input_image);
+
+		/**
+		* Generates the same field as {@link #generate} with an exact algorithm, and also keeps where the
+		* closest pixel of the opposite color of every output pixel is. From these, the distances for any
+		* smaller spread, the direction to the edge, or a dilation can be derived without searching again.
+		*
+		* <p> The search walks outwards like {@code algorithm::spiral}, whatever the algorithm is set to.
+		* {@code coverage} and {@code grayscale} are not pixel exact, so they are searched on the two-color
+		* mask as well. The kept mask of {@link #regenerate} is not touched.
+		*
+		* @param nearest receives one offset per output pixel, row by row
+		* @throws std::exception if the spread does not fit in 16-bit offsets
+		*/
+		image_ptr generate_nearest(const image& input_image, std::vector<feature_offset>& nearest);
+
+		/**
+		* Generates one field per variant from a single distance transform of the whole input, instead of
+		* one full generation per variant. The transform runs at input resolution, out to the largest spread,
+		* and every variant samples it at its own downscale, so the total cost is about that of one field at
+		* downscale 1, whatever the number of variants.
+		*
+		* <p> Each field is identical to what {@link #generate} returns with that spread and downscale and an
+		* exact algorithm, in the selected {@link #format} and color, whatever the algorithm is set to.
+		* This takes two 32-bit values per input pixel of scratch memory. The kept mask of {@link #regenerate}
+		* is not touched.
+		*
+		* @return one field per variant, in the same order
+		* @throws std::exception if there are no variants, or one has a spread or downscale that is not positive
+		*/
+		std::vector<image_ptr> generate_variants(const image& input_image, const std::vector<variant>& variants);
+
+		/**
+		* Updates a distance field after parts of its input changed, much faster than generating it again.
+		*
+		* <p> {@code output_image} must have been returned by the last call to {@link #generate} with the same
+		* settings, for an earlier version of {@code input_image}. The mask kept from that call is updated
+		* within the {@code dirty} rectangles (in input pixels), and only the output pixels within
+		* {@link #spread} of them are generated again, in place. If there is no kept mask of the right size,
+		* the whole field is generated again.
+		*
+		* @throws std::exception if {@code output_image} does not have the size of the field of {@code input_image}
+		*/
+		void regenerate(const image& input_image, image& output_image, const std::vector<rectangle>& dirty);
+
+		/**
+		* Generates a distance field row by row, for images too large to keep in memory.
+		*
+		* <p> Input rows are requested from {@code source} in order, top to bottom, each at most once.
+		* Only a band of about {@code 2 * spread + downscale} rows is kept, packed at one bit per pixel,
+		* and every output row is handed to {@code sink}, also in order, as soon as the band holds its
+		* whole window. Peak memory is therefore proportional to the width and the spread, not the height.
+		*
+		* <p> The output is the same as {@link #generate} with {@code algorithm::brute_force}, whatever
+		* the algorithm is set to.
+		*
+		* @param in_width the width of the input in pixels
+		* @param in_height the height of the input in pixels
+		* @return {@code false} if {@code source} or {@code sink} stopped the generation
+		*/
+		bool generate_stream(const uint32_t in_width, const uint32_t in_height, const row_source& source, const row_sink& sink);
+
+		/**
+		* Generates a distance field from one file-backed image into another, one output tile at a time,
+		* so neither has to fit in memory.
+		*
+		* <p> Every tile of {@code output} is generated from the region of {@code input} under it plus
+		* a halo of {@link #tile_halo} pixels on every side, which holds everything the selected algorithm
+		* looks at for the pixels of that tile. Besides the mapped tiles, only that region is held in memory.
+		*
+		* @param output must be {@code downscale} times smaller than {@code input}, rounded downwards
+		* @throws std::exception if the sizes do not match
+		*/
+		void generate(tiled_image& input, tiled_image& output);
+
+		/**
+		* Returns the number of input pixels around a region that affect the output pixels under it,
+		* always a multiple of {@link #downscale}.
+		*/
+		uint32_t tile_halo() const;
+
+		/**
+		* Generates the output pixels in the rectangle from {@code (x, y)} of size {@code width} by
+		* {@code height} (in output pixels) from {@code input}, and writes them into {@code output}.
+		*/
+		void generate_region(tiled_image& input, tiled_image& output, const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height);
+
 	private:
+		/** Returns the thread pool matching {@link #m_threads}, starting it if needed. */
+		thread_pool& pool();
+
 		/**
 		* Returns {@code true} if the color is considered as the "inside" of the image,
 		* {@code false} if considered "outside".
@@ -82,8 +419,74 @@ namespace sdfgen {
 		*/
 		inline static bool is_inside(const uint32_t color) { return (color & 0x808080) != 0 && (color & 0x80000000) != 0; }
 
+		/** Packs a row of pixels into a row of {@code mask}, see {@link #is_inside}. */
+		static void threshold_row(const uint32_t * pixels, const uint32_t width, uint64_t * mask_row);
+
+		/** Packs a whole image into {@code mask}, which must have the same size. */
+		void threshold(const image& input_image, bitmap& mask);
+
+		/**
+		* Same as {@link #is_inside} for a pixel of {@code Channels} bytes as decoded from a file: gray, gray and
+		* alpha, RGB or RGBA. Gray stands for all three color channels, and a missing alpha channel for opaque.
+		*/
+		template<uint32_t Channels>
+		inline static bool is_inside(const byte * pixel)
+		{
+			const byte color = Channels >= 3 ? (byte) (pixel[0] | pixel[1] | pixel[2]) : pixel[0];
+			return (color & 0x80) != 0 && (Channels % 2 == 1 || (pixel[Channels - 1] & 0x80) != 0);
+		}
+
+		/** Same as {@link #threshold_row} for pixels of {@code Channels} bytes, see {@link #is_inside(const byte *)}. */
+		template<uint32_t Channels>
+		static void threshold_row(const byte * pixels, const uint32_t width, uint64_t * mask_row)
+		{
+			for(uint32_t x = 0; x < width; x += bitmap::word_bits) {
+				const uint32_t count = std::min<uint32_t>(bitmap::word_bits, width - x);
+				uint64_t word = 0;
+				for(uint32_t bit = 0; bit < count; ++bit) {
+					word |= (uint64_t) is_inside<Channels>(pixels + (size_t) (x + bit) * Channels) << bit;
+				}
+				mask_row[x / bitmap::word_bits] = word;
+			}
+		}
+
+		/** Packs a whole decoded file of {@code channels} bytes per pixel into {@code mask}, which must have the same size. */
+		void threshold(const byte * pixels, const uint32_t channels, bitmap& mask);
+
+		/**
+		* Stores a row of signed distances as output row {@code y} in the selected {@link #format},
+		* see {@link simd_kernels#encode_rgba} and {@link simd_kernels#encode_half}.
+		*/
+		void encode_row(const float * signed_distances, const uint32_t out_width, byte_ptr out_pixels, const uint32_t y) const { encode_row(signed_distances, out_width, out_pixels, y, m_spread); }
+
+		/** Same as above, but normalizes by {@code spread} instead of {@link #spread}. */
+		void encode_row(const float * signed_distances, const uint32_t out_width, byte_ptr out_pixels, const uint32_t y, const float spread) const;
+
+		/** Fills the output pixels from {@code mask} with the selected algorithm, which must not be {@code grayscale}. */
+		void generate_from_mask(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Returns the input pixels needed to generate the output pixels in {@code area}: the area scaled up
+		* by {@link #downscale} and grown by {@link #tile_halo}, limited to the input.
+		*/
+		rectangle input_window(const rectangle& area, const uint32_t in_width, const uint32_t in_height) const;
+
+		/** Generates the output pixels in {@code area} again from the kept mask, or from {@code input_image} for {@code grayscale}. */
+		void regenerate_region(const image& input_image, byte_ptr out_pixels, const uint32_t out_width, const rectangle& area);
+
+		/**
+		* Returns how much of a pixel is "inside", from 0 to 1. This is the brightest color channel,
+		* limited by the alpha channel, so that it is above 0.5 exactly where {@link #is_inside} holds.
+		*/
+		inline static float coverage_of(const uint32_t color)
+		{
+			const uint32_t brightest = std::max<uint32_t>(color & 0xFF, std::max<uint32_t>((color >> 8) & 0xFF, (color >> 16) & 0xFF));
+			return (float) std::min<uint32_t>(brightest, color >> 24) / 255.0f;
+		}
+
 		/**
 		* For a distance as returned by {@link #findSignedDistance}, returns the corresponding "RGB" (really RGBA) color value.
+		* Whole rows are encoded the same way by {@link simd_kernels#encode_rgba}.
 		*
 		* @param signedDistance the signed distance of a pixel
 		* @return an RGBA color value suitable for {@link BufferedImage#setRGB}.
@@ -107,23 +510,215 @@ namespace sdfgen {
 		}
 
 		/**
-		* Returns the signed distance for a given point.
+		* Returns the signed square, see {@link #signed_square}, for a given point.
+		*
+		* For points "inside", this is the squared distance to the closest "outside" pixel.
+		* For points "outside", this is the squared distance to the closest "inside" pixel.
+		* If no pixel of different color is found within a radius of {@code ceil(spread)}, the squared
+		* distance is {@code ceil(spread)} squared.
 		*
-		* For points "inside", this is the distance to the closest "outside" pixel.
-		* For points "outside", this is the <em>negative</em> distance to the closest "inside" pixel.
-		* If no pixel of different color is found within a radius of {@code spread}, returns
-		* the {@code -spread} or {@code spread}, respectively.
+		* <p> Each row of the window is searched a word at a time, see {@link bitmap#find_nearest_in_row},
+		* and the closest of the rows is picked by {@link simd_kernels#min_square_distance}.
 		*
 		* @param centerX the x coordinate of the center point
 		* @param centerY the y coordinate of the center point
-		* @param bitmap the array representation of an image, {@code true} representing "inside"
+		* @param mask the packed representation of an image, {@code true} representing "inside"
+		* @param row_distances scratch space for {@code 2 * ceil(spread) + 1} values
+		* @return the signed square
+		*/
+		int32_t find_signed_square(const int x_center, const int y_center, const bitmap& mask, int32_t * row_distances);
+
+		/**
+		* Packs the squared distance to the closest pixel of the opposite color and the side it was measured from
+		* into one value: the squared distance itself for points "inside", its bitwise complement for points "outside".
+		*/
+		inline static int32_t signed_square(const int32_t square_distance, const bool inside) { return inside ? square_distance : ~square_distance; }
+
+		/** Builds the table used by {@link #encode_square_row} if it is enabled and out of date, or drops it if it is disabled. */
+		void update_lookup_table();
+
+		/**
+		* Stores a row of signed squares, see {@link #signed_square}, as output row {@code y}. Uses the table
+		* built by {@link #update_lookup_table} if there is one, otherwise converts them into {@code signed_distances}
+		* and stores those with {@link #encode_row}.
+		*
+		* @param signed_distances scratch space for {@code out_width} values
+		*/
+		void encode_square_row(const int32_t * signed_squares, float * signed_distances, const uint32_t out_width, byte_ptr out_pixels, const uint32_t y) const;
+
+		/** Looks up every signed square in {@code table}, which is indexed from {@code -ceil(spread)^2 - 1}. */
+		template<typename T>
+		inline static void lookup_row(const int32_t * signed_squares, const uint32_t count, const T * table, T * out_pixels)
+		{
+			for(uint32_t x = 0; x < count; ++x) {
+				out_pixels[x] = table[signed_squares[x]];
+			}
+		}
+
+		/**
+		* Converts the squared distance to the closest pixel of the opposite color into a signed distance,
+		* limited to {@code spread} as done by {@link #find_signed_square}.
+		*
+		* @param square_distance the squared distance, at most {@code ceil(spread)} squared
+		* @param inside whether the point is "inside"
 		* @return the signed distance
 		*/
-		float find_signed_distance(const int x_center, const int y_center, const bool * bitmap, const int width, const int height);
+		float to_signed_distance(const int square_distance, const bool inside) const;
+
+		/** What a tile of output pixels can see within {@link #spread}, see {@link #classify_tiles}. */
+		enum tile_class : uint8_t { tile_mixed, tile_outside, tile_inside };
+
+		/**
+		* Sorts the output into tiles of {@link #tile_size} pixels and checks, in constant time per tile,
+		* whether the window of each tile grown by {@code ceil(spread) - 1} pixels holds only one color.
+		* Every pixel of such a tile is exactly {@code spread} from the edge, so the window searches can
+		* skip them, and their cost follows the length of the edges instead of the area of the image.
+		*
+		* @param tiles receives {@code ceil(out_width / tile_size) * ceil(out_height / tile_size)} values, row by row
+		*/
+		void classify_tiles(const bitmap& mask, const uint32_t out_width, const uint32_t out_height, std::vector<tile_class>& tiles);
+
+		/**
+		* Fills the output pixels by scanning a window around each of them, see {@link #find_signed_square}.
+		*/
+		void generate_brute_force(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Runs {@link #generate_brute_force_window} instead of the generic search when {@code ceil(spread)} is
+		* 8, 16, 32 or 64.
+		*
+		* @param tiles as returned by {@link #classify_tiles}
+		* @return {@code false} if there is no specialized search for this spread
+		*/
+		bool generate_brute_force_fixed(const bitmap& mask, const std::vector<tile_class>& tiles, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Same as {@link #generate_brute_force} for {@code ceil(spread) == Delta}, with the window search
+		* compiled for it, see {@link window_search}.
+		*/
+		template<int32_t Delta>
+		void generate_brute_force_window(const bitmap& mask, const std::vector<tile_class>& tiles, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Fills the output pixels of mixed tiles with {@code search(source, center_x, center_y, row_distances)},
+		* the signed square of the window around that pixel of {@code source}, and the others from their tile.
+		* The output is traversed in blocks of {@link #window_block_size}, {@code source} being a copy of the
+		* part of {@code mask} a block reaches, or row by row over {@code mask} itself.
+		*
+		* @param tiles as returned by {@link #classify_tiles}
+		* @param search {@code row_distances} has room for {@code 2 * ceil(spread) + 1} values
+		*/
+		template<typename Search>
+		void scan_windows(const bitmap& mask, const std::vector<tile_class>& tiles, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height, const Search& search);
+
+		/**
+		* Returns the side in output pixels of the blocks {@link #scan_windows} goes through, or 0 to go row by row
+		* because the windows of a whole output row already fit in {@link #cache_block_bytes}.
+		*/
+		uint32_t window_block_size(const bitmap& mask) const;
+
+		/**
+		* Fills the output pixels using an exact Euclidean distance transform, once towards the "outside"
+		* and once towards the "inside" pixels.
+		*/
+		void generate_edt(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Fills the output pixels by walking the offsets returned by {@link #sorted_offsets} around each of them,
+		* see {@link #find_signed_square_spiral}.
+		*/
+		void generate_spiral(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Returns every offset closer than {@code ceil(spread)} to the center, sorted by increasing distance.
+		* The table is built on the first call and kept until the spread changes.
+		*/
+		const std::vector<offset>& sorted_offsets();
+
+		/**
+		* Returns the same signed square as {@link #find_signed_square}, but stops at the first pixel of the
+		* opposite color found while walking {@code offsets} outwards from the center.
+		*
+		* @param offsets the table returned by {@link #sorted_offsets}
+		*/
+		int32_t find_signed_square_spiral(const int center_x, const int center_y, const bitmap& mask, const std::vector<offset>& offsets) const;
+
+		/**
+		* Returns the first offset in {@code offsets} that leads from the center to a pixel of the opposite color,
+		* or {@code nullptr} if there is none. {@link #find_signed_square_spiral} is built on this.
+		*/
+		const offset * find_nearest_spiral(const int center_x, const int center_y, const bitmap& mask, const std::vector<offset>& offsets) const;
+
+		typedef std::vector<offset>::const_iterator offset_iterator;
+
+		/**
+		* Walks the offsets from {@code first} to {@code last} outwards from the center until it finds a pixel
+		* of another color than the center, looking only at the pixels set in {@code border}, which must
+		* include every pixel next to another color.
+		*
+		* @param first where to start in the table returned by {@link #sorted_offsets}, anything before it must be known not to match
+		* @param color receives the color of the pixel found, if any
+		* @return the squared distance to that pixel, or {@code ceil(spread)} squared if there is none
+		*/
+		int find_nearest_label(const int center_x, const int center_y, const image& input_image, const bitmap& border, const offset_iterator first, const offset_iterator last, uint32_t& color) const;
+
+		/**
+		* Fills the output pixels from the closest pixels found by {@link dead_reckoning#find_nearest}.
+		*/
+		void generate_dead_reckoning(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Fills the output pixels from the closest pixels found by {@link jump_flood#find_nearest}.
+		*/
+		void generate_jump_flood(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Fills the output pixels by querying the edge pixels of the opposite color, see {@link edge_grid}.
+		*/
+		void generate_edge_grid(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Fills the output pixels from the coverage of each {@link #downscale} block, see {@link antialiased_edt}.
+		*/
+		void generate_coverage(const bitmap& mask, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Fills the output pixels from the average {@link #coverage_of} each {@link #downscale} block of the input image.
+		*/
+		void generate_grayscale(const image& input_image, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
+
+		/**
+		* Fills the output pixels from the coverage of every output pixel, see {@link antialiased_edt}.
+		*
+		* @param coverage {@code out_width * out_height} values from 0 to 1
+		*/
+		void generate_antialiased(const std::vector<float>& coverage, byte_ptr out_pixels, const uint32_t out_width, const uint32_t out_height);
 	};
 
 	__declspec(dllexport) bool sdf_generate_export(
 		const uint8_t * input_buffer, const uint32_t input_width, const uint32_t input_height,
 		const int32_t downscale, const float spread,
-		uint8_t * output_buffer);
+		uint8_t * output_buffer, const uint32_t threads = sdf_generator::default_threads);
+
+	/**
+	* Same as {@link #sdf_generate_export}, but fills {@code output_buffer} with one alpha byte per output pixel,
+	* {@code (input_width / downscale) * (input_height / downscale)} bytes in all.
+	*/
+	__declspec(dllexport) bool sdf_generate_r8_export(
+		const uint8_t * input_buffer, const uint32_t input_width, const uint32_t input_height,
+		const int32_t downscale, const float spread,
+		uint8_t * output_buffer, const uint32_t threads = sdf_generator::default_threads);
+
+	/** Fills {@code pixels} with {@code width * 4} bytes of RGBA input row {@code y}. Returns {@code false} to stop. */
+	typedef bool (*sdf_read_row_callback)(const uint32_t y, uint8_t * pixels, void * user_data);
+
+	/** Receives {@code width / downscale * 4} bytes of RGBA output row {@code y}. Returns {@code false} to stop. */
+	typedef bool (*sdf_write_row_callback)(const uint32_t y, const uint8_t * pixels, void * user_data);
+
+	/** Streaming version of {@link #sdf_generate_export}, see {@link sdf_generator#generate_stream}. */
+	__declspec(dllexport) bool sdf_generate_stream_export(
+		const uint32_t input_width, const uint32_t input_height,
+		const int32_t downscale, const float spread,
+		sdf_read_row_callback read_row, sdf_write_row_callback write_row, void * user_data,
+		const uint32_t threads = sdf_generator::default_threads);
 }
\ No newline at end of file
@@ -0,0 +1,483 @@
+#include "simd_kernels.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef SDFGEN_X86
+#	include <immintrin.h>
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#	endif
+#endif
+
+// MSVC accepts any intrinsic in any function. GCC and Clang need to be told which functions may use them:
+#if defined(SDFGEN_X86) && !defined(_MSC_VER)
+#	define SDFGEN_TARGET(isa) __attribute__((target(isa)))
+#else
+#	define SDFGEN_TARGET(isa)
+#endif
+
+#undef min
+#undef max
+
+using namespace sdfgen;
+
+// ----------------------------------------------------------------------------
+// SCALAR:
+
+static int32_t min_square_distance_scalar(const int32_t * row_distances, const int32_t count, const int32_t first_dy, const int32_t closest)
+{
+	int32_t result = closest;
+	for(int32_t i = 0; i < count; ++i) {
+		const int32_t dx = row_distances[i];
+		if(dx >= 0) {
+			const int32_t dy = first_dy + i;
+			const int32_t square_distance = dx * dx + dy * dy;
+			if(square_distance < result) result = square_distance;
+		}
+	}
+	return result;
+}
+
+static inline uint32_t encode_rgba_one(const float signed_distance, const float spread, const uint32_t color)
+{
+	float alpha = 0.5f + 0.5f * (signed_distance / spread);
+	alpha = std::min<float>(1.0f, std::max<float>(0.0f, alpha));
+	const uint8_t alpha_byte = (uint8_t) (alpha * 255.0f);
+	return ((uint32_t) alpha_byte << 24) | (color & 0xFFFFFF);
+}
+
+static void encode_rgba_scalar(const float * signed_distances, const uint32_t count, const float spread, const uint32_t color, uint32_t * out_pixels)
+{
+	for(uint32_t i = 0; i < count; ++i) {
+		out_pixels[i] = encode_rgba_one(signed_distances[i], spread, color);
+	}
+}
+
+static void encode_alpha_scalar(const float * signed_distances, const uint32_t count, const float spread, uint8_t * out_pixels)
+{
+	for(uint32_t i = 0; i < count; ++i) {
+		out_pixels[i] = (uint8_t) (encode_rgba_one(signed_distances[i], spread, 0) >> 24);
+	}
+}
+
+// Rounds to nearest even like the hardware conversions do (after Fabian Giesen's float_to_half_fast3_rtne):
+static inline uint16_t encode_half_one(const float value)
+{
+	uint32_t bits = 0;
+	std::memcpy(&bits, &value, sizeof(bits));
+	const uint32_t sign = bits & 0x80000000U;
+	bits ^= sign;
+
+	uint16_t half = 0;
+	if(bits >= (143U << 23)) {
+		// Too large for half precision, or infinity, or NaN:
+		half = bits > (255U << 23) ? 0x7E00 : 0x7C00;
+	}
+	else if(bits < (113U << 23)) {
+		// Subnormal or zero. Adding a magic number lines the ten mantissa bits up at the bottom,
+		// and the addition itself rounds to nearest even:
+		const uint32_t magic_bits = 126U << 23;
+		float magic = 0.0f, sum = 0.0f;
+		std::memcpy(&magic, &magic_bits, sizeof(magic));
+		std::memcpy(&sum, &bits, sizeof(sum));
+		sum += magic;
+		uint32_t sum_bits = 0;
+		std::memcpy(&sum_bits, &sum, sizeof(sum_bits));
+		half = (uint16_t) (sum_bits - magic_bits);
+	}
+	else {
+		const uint32_t odd = (bits >> 13) & 1U;
+		bits += ((uint32_t) (15 - 127) << 23) + 0xFFF + odd;
+		half = (uint16_t) (bits >> 13);
+	}
+
+	return half | (uint16_t) (sign >> 16);
+}
+
+static inline float decode_half_one(const uint16_t half)
+{
+	const uint32_t sign = (uint32_t) (half & 0x8000) << 16;
+	const uint32_t exponent = (half >> 10) & 0x1F;
+	const uint32_t mantissa = half & 0x3FF;
+	uint32_t bits = 0;
+
+	if(exponent == 0x1F) bits = sign | 0x7F800000U | (mantissa << 13);
+	else if(exponent != 0) bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+	else {
+		// Zero or subnormal, which is mantissa * 2^-24 and always a normal float:
+		const float value = (float) mantissa * (1.0f / 16777216.0f);
+		std::memcpy(&bits, &value, sizeof(bits));
+		bits |= sign;
+	}
+
+	float value = 0.0f;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+static void encode_half_scalar(const float * values, const uint32_t count, uint16_t * out_values)
+{
+	for(uint32_t i = 0; i < count; ++i) {
+		out_values[i] = encode_half_one(values[i]);
+	}
+}
+
+static void decode_half_scalar(const uint16_t * values, const uint32_t count, float * out_values)
+{
+	for(uint32_t i = 0; i < count; ++i) {
+		out_values[i] = decode_half_one(values[i]);
+	}
+}
+
+#ifdef SDFGEN_X86
+
+// ----------------------------------------------------------------------------
+// SSE2:
+
+// SSE2 has neither a 32-bit multiply nor a 32-bit minimum, but the distances fit in 16 bits,
+// so each (dx, dy) pair goes into one 32-bit lane and _mm_madd_epi16 yields dx*dx + dy*dy.
+SDFGEN_TARGET("sse2")
+static int32_t min_square_distance_sse2(const int32_t * row_distances, const int32_t count, const int32_t first_dy, const int32_t closest)
+{
+	if(first_dy < -32767 || first_dy + count > 32768) {
+		return min_square_distance_scalar(row_distances, count, first_dy, closest);
+	}
+
+	const __m128i low_mask = _mm_set1_epi32(0xFFFF);
+	const __m128i none = _mm_set1_epi32(-1);
+	const __m128i step = _mm_set1_epi32(4);
+	__m128i dy = _mm_add_epi32(_mm_set1_epi32(first_dy), _mm_set_epi32(3, 2, 1, 0));
+	__m128i result = _mm_set1_epi32(closest);
+	int32_t i = 0;
+
+	for(; i + 4 <= count; i += 4) {
+		const __m128i dx = _mm_loadu_si128((const __m128i *) (row_distances + i));
+		const __m128i pair = _mm_or_si128(_mm_and_si128(dx, low_mask), _mm_slli_epi32(dy, 16));
+		const __m128i square_distance = _mm_madd_epi16(pair, pair);
+		const __m128i smaller = _mm_and_si128(_mm_cmpgt_epi32(dx, none), _mm_cmplt_epi32(square_distance, result));
+		result = _mm_or_si128(_mm_and_si128(smaller, square_distance), _mm_andnot_si128(smaller, result));
+		dy = _mm_add_epi32(dy, step);
+	}
+
+	alignas(16) int32_t lanes[4];
+	_mm_store_si128((__m128i *) lanes, result);
+	const int32_t vector_result = std::min<int32_t>(std::min<int32_t>(lanes[0], lanes[1]), std::min<int32_t>(lanes[2], lanes[3]));
+	return min_square_distance_scalar(row_distances + i, count - i, first_dy + i, vector_result);
+}
+
+SDFGEN_TARGET("sse2")
+static void encode_rgba_sse2(const float * signed_distances, const uint32_t count, const float spread, const uint32_t color, uint32_t * out_pixels)
+{
+	const __m128 spread_v = _mm_set1_ps(spread);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(255.0f);
+	const __m128i rgb = _mm_set1_epi32((int32_t) (color & 0xFFFFFF));
+	uint32_t i = 0;
+
+	for(; i + 4 <= count; i += 4) {
+		__m128 alpha = _mm_add_ps(half, _mm_mul_ps(half, _mm_div_ps(_mm_loadu_ps(signed_distances + i), spread_v)));
+		alpha = _mm_min_ps(_mm_max_ps(alpha, zero), one);
+		const __m128i alpha_byte = _mm_cvttps_epi32(_mm_mul_ps(alpha, scale));
+		_mm_storeu_si128((__m128i *) (out_pixels + i), _mm_or_si128(_mm_slli_epi32(alpha_byte, 24), rgb));
+	}
+
+	encode_rgba_scalar(signed_distances + i, count - i, spread, color, out_pixels + i);
+}
+
+// The alpha values are at most 255, so the saturating packs never change them:
+SDFGEN_TARGET("sse2")
+static void encode_alpha_sse2(const float * signed_distances, const uint32_t count, const float spread, uint8_t * out_pixels)
+{
+	const __m128 spread_v = _mm_set1_ps(spread);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(255.0f);
+	uint32_t i = 0;
+
+	for(; i + 16 <= count; i += 16) {
+		__m128i alpha_bytes[4];
+		for(uint32_t j = 0; j < 4; ++j) {
+			__m128 alpha = _mm_add_ps(half, _mm_mul_ps(half, _mm_div_ps(_mm_loadu_ps(signed_distances + i + j * 4), spread_v)));
+			alpha = _mm_min_ps(_mm_max_ps(alpha, zero), one);
+			alpha_bytes[j] = _mm_cvttps_epi32(_mm_mul_ps(alpha, scale));
+		}
+		const __m128i low = _mm_packs_epi32(alpha_bytes[0], alpha_bytes[1]);
+		const __m128i high = _mm_packs_epi32(alpha_bytes[2], alpha_bytes[3]);
+		_mm_storeu_si128((__m128i *) (out_pixels + i), _mm_packus_epi16(low, high));
+	}
+
+	encode_alpha_scalar(signed_distances + i, count - i, spread, out_pixels + i);
+}
+
+// ----------------------------------------------------------------------------
+// AVX2:
+
+SDFGEN_TARGET("avx2")
+static int32_t min_square_distance_avx2(const int32_t * row_distances, const int32_t count, const int32_t first_dy, const int32_t closest)
+{
+	const __m256i none = _mm256_set1_epi32(-1);
+	const __m256i step = _mm256_set1_epi32(8);
+	__m256i dy = _mm256_add_epi32(_mm256_set1_epi32(first_dy), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+	__m256i result = _mm256_set1_epi32(closest);
+	int32_t i = 0;
+
+	for(; i + 8 <= count; i += 8) {
+		const __m256i dx = _mm256_loadu_si256((const __m256i *) (row_distances + i));
+		const __m256i square_distance = _mm256_add_epi32(_mm256_mullo_epi32(dx, dx), _mm256_mullo_epi32(dy, dy));
+		result = _mm256_blendv_epi8(result, _mm256_min_epi32(result, square_distance), _mm256_cmpgt_epi32(dx, none));
+		dy = _mm256_add_epi32(dy, step);
+	}
+
+	__m128i half = _mm_min_epi32(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1));
+	half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+	half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+	return min_square_distance_scalar(row_distances + i, count - i, first_dy + i, _mm_cvtsi128_si32(half));
+}
+
+SDFGEN_TARGET("avx2")
+static void encode_rgba_avx2(const float * signed_distances, const uint32_t count, const float spread, const uint32_t color, uint32_t * out_pixels)
+{
+	const __m256 spread_v = _mm256_set1_ps(spread);
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 scale = _mm256_set1_ps(255.0f);
+	const __m256i rgb = _mm256_set1_epi32((int32_t) (color & 0xFFFFFF));
+	uint32_t i = 0;
+
+	for(; i + 8 <= count; i += 8) {
+		__m256 alpha = _mm256_add_ps(half, _mm256_mul_ps(half, _mm256_div_ps(_mm256_loadu_ps(signed_distances + i), spread_v)));
+		alpha = _mm256_min_ps(_mm256_max_ps(alpha, zero), one);
+		const __m256i alpha_byte = _mm256_cvttps_epi32(_mm256_mul_ps(alpha, scale));
+		_mm256_storeu_si256((__m256i *) (out_pixels + i), _mm256_or_si256(_mm256_slli_epi32(alpha_byte, 24), rgb));
+	}
+
+	encode_rgba_scalar(signed_distances + i, count - i, spread, color, out_pixels + i);
+}
+
+// The packs work within 128-bit halves, the final permutation puts the four groups back in order:
+SDFGEN_TARGET("avx2")
+static void encode_alpha_avx2(const float * signed_distances, const uint32_t count, const float spread, uint8_t * out_pixels)
+{
+	const __m256 spread_v = _mm256_set1_ps(spread);
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 scale = _mm256_set1_ps(255.0f);
+	const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+	uint32_t i = 0;
+
+	for(; i + 32 <= count; i += 32) {
+		__m256i alpha_bytes[4];
+		for(uint32_t j = 0; j < 4; ++j) {
+			__m256 alpha = _mm256_add_ps(half, _mm256_mul_ps(half, _mm256_div_ps(_mm256_loadu_ps(signed_distances + i + j * 8), spread_v)));
+			alpha = _mm256_min_ps(_mm256_max_ps(alpha, zero), one);
+			alpha_bytes[j] = _mm256_cvttps_epi32(_mm256_mul_ps(alpha, scale));
+		}
+		const __m256i low = _mm256_packs_epi32(alpha_bytes[0], alpha_bytes[1]);
+		const __m256i high = _mm256_packs_epi32(alpha_bytes[2], alpha_bytes[3]);
+		_mm256_storeu_si256((__m256i *) (out_pixels + i), _mm256_permutevar8x32_epi32(_mm256_packus_epi16(low, high), order));
+	}
+
+	encode_alpha_scalar(signed_distances + i, count - i, spread, out_pixels + i);
+}
+
+SDFGEN_TARGET("avx2,f16c")
+static void encode_half_avx2(const float * values, const uint32_t count, uint16_t * out_values)
+{
+	uint32_t i = 0;
+	for(; i + 8 <= count; i += 8) {
+		_mm_storeu_si128((__m128i *) (out_values + i), _mm256_cvtps_ph(_mm256_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT));
+	}
+	encode_half_scalar(values + i, count - i, out_values + i);
+}
+
+SDFGEN_TARGET("avx2,f16c")
+static void decode_half_avx2(const uint16_t * values, const uint32_t count, float * out_values)
+{
+	uint32_t i = 0;
+	for(; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(out_values + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (values + i))));
+	}
+	decode_half_scalar(values + i, count - i, out_values + i);
+}
+
+// ----------------------------------------------------------------------------
+// AVX-512:
+
+// Masked loads and stores take care of the tail, so there is no scalar remainder here.
+SDFGEN_TARGET("avx512f")
+static int32_t min_square_distance_avx512(const int32_t * row_distances, const int32_t count, const int32_t first_dy, const int32_t closest)
+{
+	const __m512i zero = _mm512_setzero_si512();
+	const __m512i step = _mm512_set1_epi32(16);
+	__m512i dy = _mm512_add_epi32(_mm512_set1_epi32(first_dy), _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+	__m512i result = _mm512_set1_epi32(closest);
+
+	for(int32_t i = 0; i < count; i += 16) {
+		const __mmask16 lanes = (count - i >= 16) ? (__mmask16) 0xFFFF : (__mmask16) ((1U << (count - i)) - 1);
+		const __m512i dx = _mm512_maskz_loadu_epi32(lanes, row_distances + i);
+		const __m512i square_distance = _mm512_add_epi32(_mm512_mullo_epi32(dx, dx), _mm512_mullo_epi32(dy, dy));
+		const __mmask16 valid = _mm512_mask_cmpge_epi32_mask(lanes, dx, zero);
+		result = _mm512_mask_min_epi32(result, valid, result, square_distance);
+		dy = _mm512_add_epi32(dy, step);
+	}
+
+	return _mm512_reduce_min_epi32(result);
+}
+
+SDFGEN_TARGET("avx512f")
+static void encode_rgba_avx512(const float * signed_distances, const uint32_t count, const float spread, const uint32_t color, uint32_t * out_pixels)
+{
+	const __m512 spread_v = _mm512_set1_ps(spread);
+	const __m512 half = _mm512_set1_ps(0.5f);
+	const __m512 zero = _mm512_setzero_ps();
+	const __m512 one = _mm512_set1_ps(1.0f);
+	const __m512 scale = _mm512_set1_ps(255.0f);
+	const __m512i rgb = _mm512_set1_epi32((int32_t) (color & 0xFFFFFF));
+
+	for(uint32_t i = 0; i < count; i += 16) {
+		const __mmask16 lanes = (count - i >= 16) ? (__mmask16) 0xFFFF : (__mmask16) ((1U << (count - i)) - 1);
+		__m512 alpha = _mm512_add_ps(half, _mm512_mul_ps(half, _mm512_div_ps(_mm512_maskz_loadu_ps(lanes, signed_distances + i), spread_v)));
+		alpha = _mm512_min_ps(_mm512_max_ps(alpha, zero), one);
+		const __m512i alpha_byte = _mm512_cvttps_epi32(_mm512_mul_ps(alpha, scale));
+		_mm512_mask_storeu_epi32(out_pixels + i, lanes, _mm512_or_si512(_mm512_slli_epi32(alpha_byte, 24), rgb));
+	}
+}
+
+SDFGEN_TARGET("avx512f")
+static void encode_alpha_avx512(const float * signed_distances, const uint32_t count, const float spread, uint8_t * out_pixels)
+{
+	const __m512 spread_v = _mm512_set1_ps(spread);
+	const __m512 half = _mm512_set1_ps(0.5f);
+	const __m512 zero = _mm512_setzero_ps();
+	const __m512 one = _mm512_set1_ps(1.0f);
+	const __m512 scale = _mm512_set1_ps(255.0f);
+
+	for(uint32_t i = 0; i < count; i += 16) {
+		const __mmask16 lanes = (count - i >= 16) ? (__mmask16) 0xFFFF : (__mmask16) ((1U << (count - i)) - 1);
+		__m512 alpha = _mm512_add_ps(half, _mm512_mul_ps(half, _mm512_div_ps(_mm512_maskz_loadu_ps(lanes, signed_distances + i), spread_v)));
+		alpha = _mm512_min_ps(_mm512_max_ps(alpha, zero), one);
+		_mm512_mask_cvtepi32_storeu_epi8(out_pixels + i, lanes, _mm512_cvttps_epi32(_mm512_mul_ps(alpha, scale)));
+	}
+}
+
+// Masked 16-bit stores would need AVX-512BW, so these leave a scalar remainder:
+SDFGEN_TARGET("avx512f")
+static void encode_half_avx512(const float * values, const uint32_t count, uint16_t * out_values)
+{
+	uint32_t i = 0;
+	for(; i + 16 <= count; i += 16) {
+		_mm256_storeu_si256((__m256i *) (out_values + i), _mm512_cvtps_ph(_mm512_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT));
+	}
+	encode_half_scalar(values + i, count - i, out_values + i);
+}
+
+SDFGEN_TARGET("avx512f")
+static void decode_half_avx512(const uint16_t * values, const uint32_t count, float * out_values)
+{
+	uint32_t i = 0;
+	for(; i + 16 <= count; i += 16) {
+		_mm512_storeu_ps(out_values + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *) (values + i))));
+	}
+	decode_half_scalar(values + i, count - i, out_values + i);
+}
+
+// ----------------------------------------------------------------------------
+// CPU DETECTION:
+
+static void cpuid(int32_t info[4], const int32_t leaf, const int32_t subleaf)
+{
+#ifdef _MSC_VER
+	__cpuidex(info, leaf, subleaf);
+#else
+	uint32_t a = 0, b = 0, c = 0, d = 0;
+	__asm__ __volatile__("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(leaf), "c"(subleaf));
+	info[0] = (int32_t) a; info[1] = (int32_t) b; info[2] = (int32_t) c; info[3] = (int32_t) d;
+#endif
+}
+
+static uint64_t xgetbv0()
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	uint32_t low = 0, high = 0;
+	__asm__ __volatile__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+	return ((uint64_t) high << 32) | low;
+#endif
+}
+
+static simd_level detect_x86()
+{
+	int32_t info[4] = { 0 };
+	cpuid(info, 0, 0);
+	const int32_t max_leaf = info[0];
+	if(max_leaf < 1) return simd_level::scalar;
+
+	cpuid(info, 1, 0);
+	const bool sse2 = (info[3] & (1 << 26)) != 0;
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	const bool f16c = (info[2] & (1 << 29)) != 0;
+	if(!sse2) return simd_level::scalar;
+	if(!osxsave || !avx || max_leaf < 7) return simd_level::sse2;
+
+	// The operating system has to save the wider registers on context switches too:
+	const uint64_t xcr0 = xgetbv0();
+	if((xcr0 & 0x6) != 0x6) return simd_level::sse2;
+
+	cpuid(info, 7, 0);
+	const bool avx2 = (info[1] & (1 << 5)) != 0;
+	const bool avx512f = (info[1] & (1 << 16)) != 0;
+	if(avx512f && f16c && (xcr0 & 0xE6) == 0xE6) return simd_level::avx512;
+	if(avx2 && f16c) return simd_level::avx2;
+	return simd_level::sse2;
+}
+
+#endif // SDFGEN_X86
+
+// ----------------------------------------------------------------------------
+// DISPATCH:
+
+simd_level sdfgen::detect_simd_level()
+{
+#ifdef SDFGEN_X86
+	static const simd_level level = detect_x86();
+	return level;
+#else
+	return simd_level::scalar;
+#endif
+}
+
+const simd_kernels& sdfgen::get_simd_kernels(const simd_level level)
+{
+	static const simd_kernels scalar = { simd_level::scalar, min_square_distance_scalar, encode_rgba_scalar, encode_alpha_scalar, encode_half_scalar, decode_half_scalar };
+#ifdef SDFGEN_X86
+	static const simd_kernels sse2 = { simd_level::sse2, min_square_distance_sse2, encode_rgba_sse2, encode_alpha_sse2, encode_half_scalar, decode_half_scalar };
+	static const simd_kernels avx2 = { simd_level::avx2, min_square_distance_avx2, encode_rgba_avx2, encode_alpha_avx2, encode_half_avx2, decode_half_avx2 };
+	static const simd_kernels avx512 = { simd_level::avx512, min_square_distance_avx512, encode_rgba_avx512, encode_alpha_avx512, encode_half_avx512, decode_half_avx512 };
+
+	switch(std::min<simd_level>(level, detect_simd_level())) {
+	case simd_level::avx512: return avx512;
+	case simd_level::avx2: return avx2;
+	case simd_level::sse2: return sse2;
+	default: return scalar;
+	}
+#else
+	return scalar;
+#endif
+}
+
+const char * sdfgen::simd_level_name(const simd_level level)
+{
+	switch(level) {
+	case simd_level::sse2: return "SSE2";
+	case simd_level::avx2: return "AVX2";
+	case simd_level::avx512: return "AVX-512";
+	default: return "scalar";
+	}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include <stdint.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#	define SDFGEN_X86 1
+#endif
+
+namespace sdfgen {
+
+	/**
+	* The instruction sets the vectorized kernels are available for, from slowest to fastest.
+	* {@code avx2} also requires F16C, which every CPU with AVX2 has.
+	*/
+	enum class simd_level { scalar, sse2, avx2, avx512 };
+
+	/**
+	* The inner loops of distance field generation, implemented once per {@link simd_level}.
+	* Every implementation produces results identical to the scalar one.
+	*/
+	struct simd_kernels {
+		simd_level level;
+
+		/**
+		* Given the horizontal distance to the closest pixel of the other color in each row of a window,
+		* returns the smallest squared distance, or {@code closest} if none is smaller.
+		*
+		* @param row_distances one horizontal distance per row, negative for rows without such a pixel.
+		* All of them must be below 32768.
+		* @param count the number of rows
+		* @param first_dy the vertical distance from the center to the first row, following rows are one further
+		* @param closest the squared distance to beat
+		*/
+		int32_t (*min_square_distance)(const int32_t * row_distances, const int32_t count, const int32_t first_dy, const int32_t closest);
+
+		/**
+		* Encodes a row of signed distances into RGBA colors, exactly like {@link sdf_generator#distance_to_rgb}.
+		*
+		* @param signed_distances {@code count} signed distances
+		* @param spread the spread the distances are normalized by
+		* @param color the color whose RGB components fill the output, its alpha component is ignored
+		* @param out_pixels receives {@code count} colors
+		*/
+		void (*encode_rgba)(const float * signed_distances, const uint32_t count, const float spread, const uint32_t color, uint32_t * out_pixels);
+
+		/** Same as {@link #encode_rgba}, but only writes the alpha byte of every color. */
+		void (*encode_alpha)(const float * signed_distances, const uint32_t count, const float spread, uint8_t * out_pixels);
+
+		/**
+		* Converts floats to IEEE 754 half precision, rounding to the nearest even value.
+		* Results are identical across levels for everything but NaN payloads.
+		*/
+		void (*encode_half)(const float * values, const uint32_t count, uint16_t * out_values);
+
+		/** Converts IEEE 754 half precision values to floats, which is always exact. */
+		void (*decode_half)(const uint16_t * values, const uint32_t count, float * out_values);
+	};
+
+	/** Returns the fastest {@link simd_level} supported by this CPU and operating system. */
+	simd_level detect_simd_level();
+
+	/**
+	* Returns the kernels for the given level, or for the fastest supported level below it
+	* when this CPU does not support it. Defaults to the fastest supported level.
+	*/
+	const simd_kernels& get_simd_kernels(const simd_level level = detect_simd_level());
+
+	/** Returns a printable name for a {@link simd_level}. */
+	const char * simd_level_name(const simd_level level);
+}
\ No newline at end of file
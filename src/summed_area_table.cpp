@@ -0,0 +1,91 @@
+#include "summed_area_table.h"
+#include <algorithm>
+
+using namespace sdfgen;
+
+summed_area_table::summed_area_table() : m_mask(nullptr), m_width(0), m_height(0)
+{
+
+}
+
+summed_area_table::~summed_area_table()
+{
+
+}
+
+void summed_area_table::build(const bitmap& mask, thread_pool& pool)
+{
+	m_mask = &mask;
+	m_width = mask.width();
+	m_height = mask.height();
+
+	// One extra row and column of zeros on the top and left keeps count() free of branches:
+	const uint32_t words = mask.stride();
+	const size_t stride = (size_t) words + 1;
+	m_sums.assign(stride * ((size_t) m_height + 1), 0);
+	if(m_height == 0) return;
+
+	// First every band sums its own rows as if it started the table:
+	const uint32_t band_height = 64;
+	const uint32_t bands = (m_height + band_height - 1) / band_height;
+	pool.parallel_for(0, bands, [&](const uint32_t begin, const uint32_t end) {
+		for(uint32_t band = begin; band < end; ++band) {
+			const uint32_t y_end = std::min(m_height, (band + 1) * band_height);
+			for(uint32_t y = band * band_height; y < y_end; ++y) {
+				const uint64_t * row = mask.row(y);
+				const uint32_t * above = y % band_height ? &m_sums[(size_t) y * stride] : nullptr;
+				uint32_t * sums = &m_sums[((size_t) y + 1) * stride];
+				uint32_t row_sum = 0;
+
+				for(uint32_t i = 0; i < words; ++i) {
+					row_sum += bitmap::count_ones(row[i]);
+					sums[i + 1] = (above ? above[i + 1] : 0) + row_sum;
+				}
+			}
+		}
+	});
+
+	// Then the last row of each band, now complete, carries over into the band below:
+	for(uint32_t band = 1; band < bands; ++band) {
+		const uint32_t * carry = &m_sums[(size_t) band * band_height * stride];
+		uint32_t * last = &m_sums[(size_t) std::min(m_height, (band + 1) * band_height) * stride];
+		for(uint32_t i = 1; i < stride; ++i) {
+			last[i] += carry[i];
+		}
+	}
+
+	pool.parallel_for(1, bands, [&](const uint32_t begin, const uint32_t end) {
+		for(uint32_t band = begin; band < end; ++band) {
+			const uint32_t * carry = &m_sums[(size_t) band * band_height * stride];
+			const uint32_t y_last = std::min(m_height, (band + 1) * band_height);
+			for(uint32_t y = band * band_height + 1; y < y_last; ++y) {
+				uint32_t * sums = &m_sums[(size_t) y * stride];
+				for(uint32_t i = 1; i < stride; ++i) {
+					sums[i] += carry[i];
+				}
+			}
+		}
+	});
+}
+
+uint32_t summed_area_table::count(const uint32_t x_begin, const uint32_t y_begin, const uint32_t x_end, const uint32_t y_end) const
+{
+	// The whole words the rectangle touches:
+	const size_t stride = (size_t) m_mask->stride() + 1;
+	const uint32_t first_word = x_begin / bitmap::word_bits;
+	const uint32_t end_word = (x_end - 1) / bitmap::word_bits + 1;
+	uint32_t count = m_sums[y_end * stride + end_word] - m_sums[y_begin * stride + end_word]
+		- m_sums[y_end * stride + first_word] + m_sums[y_begin * stride + first_word];
+
+	// Less the bits before x_begin and from x_end on in those words. Bits past the width are always zero:
+	const uint64_t first_cut = (1ULL << (x_begin % bitmap::word_bits)) - 1;
+	const uint64_t last_cut = x_end % bitmap::word_bits && x_end < m_width ? ~0ULL << (x_end % bitmap::word_bits) : 0;
+	if(first_cut || last_cut) {
+		for(uint32_t y = y_begin; y < y_end; ++y) {
+			const uint64_t * row = m_mask->row(y);
+			count -= bitmap::count_ones(row[first_word] & first_cut) + bitmap::count_ones(row[end_word - 1] & last_cut);
+		}
+	}
+
+	return count;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "bitmap.h"
+#include "thread_pool.h"
+
+namespace sdfgen {
+
+	/**
+	* An integral image of a bitmap at the granularity of its 64-bit words: entry {@code (i, y)} holds the
+	* number of "inside" pixels in words {@code 0} to {@code i - 1} of rows {@code 0} to {@code y - 1}.
+	* The number of "inside" pixels in any rectangle takes four lookups, plus a count of the bits cut off
+	* in its first and last word on each of its rows.
+	*
+	* <p> With one entry per word instead of per pixel, the table takes half the memory of the bitmap.
+	* The sums may wrap around, but the count of any rectangle below 2^32 pixels is still exact.
+	*/
+	class summed_area_table {
+	private:
+		std::vector<uint32_t> m_sums;
+		const bitmap * m_mask;
+		uint32_t m_width;
+		uint32_t m_height;
+
+	public:
+		summed_area_table();
+		~summed_area_table();
+
+		/**
+		* Replaces the table with the sums of {@code mask}, in bands of rows spread over {@code pool}.
+		* The bitmap must outlive the table, {@link #count} reads it.
+		*/
+		void build(const bitmap& mask, thread_pool& pool);
+
+		const uint32_t& width() const { return m_width; }
+		const uint32_t& height() const { return m_height; }
+
+		/**
+		* Returns the number of "inside" pixels in the rectangle from {@code (x_begin, y_begin)} inclusive
+		* to {@code (x_end, y_end)} exclusive. The rectangle must lie within the bitmap and not be empty.
+		*/
+		uint32_t count(const uint32_t x_begin, const uint32_t y_begin, const uint32_t x_end, const uint32_t y_end) const;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+#undef min
+#undef max
+
+using namespace sdfgen;
+
+thread_pool::thread_pool(const uint32_t threads)
+{
+	const uint32_t count = threads ? threads : std::max<uint32_t>(1U, std::thread::hardware_concurrency());
+	for(uint32_t i = 1; i < count; ++i) {
+		m_workers.emplace_back(&thread_pool::worker, this);
+	}
+}
+
+thread_pool::~thread_pool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	for(std::thread& worker : m_workers) {
+		if(worker.joinable()) worker.join();
+	}
+}
+
+void thread_pool::parallel_for(const uint32_t begin, const uint32_t end, const range_function& function)
+{
+	if(end <= begin) return;
+
+	const uint32_t count = end - begin;
+	if(m_workers.empty() || count == 1) {
+		function(begin, end);
+		return;
+	}
+
+	// Only one range is handed out at a time, other callers wait here for their turn:
+	std::lock_guard<std::mutex> job_lock(m_job_mutex);
+
+	// A few chunks per thread keeps them all busy when some rows are cheaper than others:
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_job = &function;
+		m_begin = begin;
+		m_count = count;
+		m_chunks = std::min<uint32_t>(count, size() * 4);
+		m_next_chunk = 0;
+		m_remaining = m_chunks;
+		m_error = nullptr;
+		++m_generation;
+	}
+	m_wake.notify_all();
+
+	run_chunks();
+
+	std::exception_ptr error;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this] { return m_remaining == 0; });
+		m_job = nullptr;
+		error = m_error;
+		m_error = nullptr;
+	}
+
+	if(error) std::rethrow_exception(error);
+}
+
+void thread_pool::worker()
+{
+	uint64_t generation = 0;
+
+	for(;;) {
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [this, generation] { return m_stop || m_generation != generation; });
+			if(m_stop) return;
+			generation = m_generation;
+		}
+
+		run_chunks();
+	}
+}
+
+void thread_pool::run_chunks()
+{
+	for(;;) {
+		const range_function * job = nullptr;
+		uint32_t begin = 0, end = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if(!m_job || m_next_chunk >= m_chunks) return;
+			const uint32_t chunk = m_next_chunk++;
+			job = m_job;
+			begin = m_begin + (uint32_t) (((uint64_t) m_count * chunk) / m_chunks);
+			end = m_begin + (uint32_t) (((uint64_t) m_count * (chunk + 1)) / m_chunks);
+		}
+
+		try {
+			(*job)(begin, end);
+		}
+		catch(...) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if(!m_error) m_error = std::current_exception();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if(--m_remaining == 0) m_done.notify_all();
+		}
+	}
+}
\ No newline at end of file
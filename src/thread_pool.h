@@ -0,0 +1,64 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+namespace sdfgen {
+
+	/**
+	* A fixed set of worker threads that split ranges of independent work items, such as image rows,
+	* between themselves. The thread calling {@link #parallel_for} takes part in the work too.
+	*/
+	class thread_pool final {
+	public:
+		typedef std::function<void(const uint32_t begin, const uint32_t end)> range_function;
+
+	private:
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::mutex m_job_mutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_done;
+		const range_function * m_job = nullptr;
+		uint32_t m_begin = 0;
+		uint32_t m_count = 0;
+		uint32_t m_chunks = 0;
+		uint32_t m_next_chunk = 0;
+		uint32_t m_remaining = 0;
+		uint64_t m_generation = 0;
+		bool m_stop = false;
+		std::exception_ptr m_error;
+
+	public:
+		/**
+		* @param threads the total number of threads to work with, including the calling thread.
+		* Zero uses one thread per hardware thread.
+		*/
+		thread_pool(const uint32_t threads = 0);
+		~thread_pool();
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		/** Returns the total number of threads doing work, including the calling thread. */
+		uint32_t size() const { return static_cast<uint32_t>(m_workers.size()) + 1U; }
+
+		/**
+		* Splits {@code [begin, end)} into contiguous sub-ranges and calls {@code function} for each of
+		* them from any of the threads. Returns once every sub-range has been processed.
+		* The first exception thrown by {@code function} is rethrown on the calling thread.
+		*/
+		void parallel_for(const uint32_t begin, const uint32_t end, const range_function& function);
+
+	private:
+		void worker();
+		void run_chunks();
+	};
+
+	typedef std::shared_ptr<thread_pool> thread_pool_ptr;
+}
\ No newline at end of file
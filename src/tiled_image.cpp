@@ -0,0 +1,174 @@
+#include "tiled_image.h"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#endif
+
+#undef min
+#undef max
+
+using namespace sdfgen;
+
+tiled_image::tiled_image(const std::string& file, const uint32_t width, const uint32_t height, const uint32_t tile_size, const size_t memory_limit)
+	: m_file(file), m_width(width), m_height(height), m_tile_size(std::max<uint32_t>(1, tile_size))
+{
+	m_tiles_x = (m_width + m_tile_size - 1) / m_tile_size;
+	m_tiles_y = (m_height + m_tile_size - 1) / m_tile_size;
+	m_tiles.resize((size_t) m_tiles_x * m_tiles_y);
+
+	// Every tile has to start on a boundary the system can map at, 64 KB covers both Windows and POSIX:
+	const uint64_t granularity = 64 * 1024;
+	m_tile_bytes = ((uint64_t) m_tile_size * m_tile_size * sizeof(uint32_t) + granularity - 1) / granularity * granularity;
+	m_max_resident = std::max<size_t>(1, (size_t) (memory_limit / m_tile_bytes));
+	const uint64_t file_bytes = m_tile_bytes * m_tiles.size();
+
+#ifdef _WIN32
+	m_mapping = nullptr;
+	m_handle = CreateFileA(m_file.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(m_handle == INVALID_HANDLE_VALUE) {
+		throw std::exception("Failed to open the tiled image file");
+	}
+	if(file_bytes > 0) {
+		// Mapping more than the file holds grows it:
+		m_mapping = CreateFileMappingA(m_handle, nullptr, PAGE_READWRITE, (DWORD) (file_bytes >> 32), (DWORD) file_bytes, nullptr);
+		if(!m_mapping) {
+			CloseHandle(m_handle);
+			throw std::exception("Failed to map the tiled image file");
+		}
+	}
+#else
+	m_handle = open(m_file.c_str(), O_RDWR | O_CREAT, 0644);
+	if(m_handle < 0) {
+		throw std::exception("Failed to open the tiled image file");
+	}
+	off_t current_bytes = lseek(m_handle, 0, SEEK_END);
+	if(current_bytes < (off_t) file_bytes && ftruncate(m_handle, (off_t) file_bytes) != 0) {
+		close(m_handle);
+		throw std::exception("Failed to grow the tiled image file");
+	}
+#endif
+}
+
+tiled_image::~tiled_image()
+{
+	for(const uint32_t index : m_recent) {
+		unmap_tile(index);
+	}
+
+#ifdef _WIN32
+	if(m_mapping) CloseHandle(m_mapping);
+	CloseHandle(m_handle);
+#else
+	close(m_handle);
+#endif
+}
+
+size_t tiled_image::resident_tiles()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_recent.size();
+}
+
+void tiled_image::read_region(const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, uint32_t * pixels, const uint32_t stride)
+{
+	for_each_segment(x, y, width, height, [&](uint32_t * tile_pixels, const uint32_t segment_x, const uint32_t segment_y, const uint32_t segment_width) {
+		std::memcpy(pixels + (size_t) (segment_y - y) * stride + (segment_x - x), tile_pixels, segment_width * sizeof(uint32_t));
+	});
+}
+
+void tiled_image::write_region(const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, const uint32_t * pixels, const uint32_t stride)
+{
+	for_each_segment(x, y, width, height, [&](uint32_t * tile_pixels, const uint32_t segment_x, const uint32_t segment_y, const uint32_t segment_width) {
+		std::memcpy(tile_pixels, pixels + (size_t) (segment_y - y) * stride + (segment_x - x), segment_width * sizeof(uint32_t));
+	});
+}
+
+void tiled_image::flush()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for(const uint32_t index : m_recent) {
+#ifdef _WIN32
+		FlushViewOfFile(m_tiles[index].pixels, 0);
+#else
+		msync(m_tiles[index].pixels, (size_t) m_tile_bytes, MS_SYNC);
+#endif
+	}
+}
+
+template<typename Copy>
+void tiled_image::for_each_segment(const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, const Copy& copy)
+{
+	if((uint64_t) x + width > m_width || (uint64_t) y + height > m_height) {
+		throw std::exception("Region is outside of the tiled image");
+	}
+	if(width == 0 || height == 0) return;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// Tile by tile, so that only one of them needs to be mapped at a time:
+	for(uint32_t tile_y = y / m_tile_size; tile_y <= (y + height - 1) / m_tile_size; ++tile_y) {
+		for(uint32_t tile_x = x / m_tile_size; tile_x <= (x + width - 1) / m_tile_size; ++tile_x) {
+			uint32_t * pixels = tile(tile_x, tile_y);
+			const uint32_t left = std::max<uint32_t>(x, tile_x * m_tile_size);
+			const uint32_t right = std::min<uint32_t>(x + width, (tile_x + 1) * m_tile_size);
+			const uint32_t top = std::max<uint32_t>(y, tile_y * m_tile_size);
+			const uint32_t bottom = std::min<uint32_t>(y + height, (tile_y + 1) * m_tile_size);
+
+			for(uint32_t row = top; row < bottom; ++row) {
+				copy(pixels + (size_t) (row - tile_y * m_tile_size) * m_tile_size + (left - tile_x * m_tile_size), left, row, right - left);
+			}
+		}
+	}
+}
+
+uint32_t * tiled_image::tile(const uint32_t tile_x, const uint32_t tile_y)
+{
+	const uint32_t index = tile_y * m_tiles_x + tile_x;
+	tile_entry& entry = m_tiles[index];
+
+	if(entry.pixels) {
+		m_recent.splice(m_recent.begin(), m_recent, entry.position);
+		return entry.pixels;
+	}
+
+	if(m_recent.size() >= m_max_resident) {
+		unmap_tile(m_recent.back());
+		m_recent.pop_back();
+	}
+
+	map_tile(index);
+	m_recent.push_front(index);
+	entry.position = m_recent.begin();
+	return entry.pixels;
+}
+
+void tiled_image::map_tile(const uint32_t index)
+{
+	const uint64_t offset = m_tile_bytes * index;
+
+#ifdef _WIN32
+	void * view = MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, (DWORD) (offset >> 32), (DWORD) offset, (SIZE_T) m_tile_bytes);
+	if(!view) throw std::exception("Failed to map a tile of the tiled image");
+#else
+	void * view = mmap(nullptr, (size_t) m_tile_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_handle, (off_t) offset);
+	if(view == MAP_FAILED) throw std::exception("Failed to map a tile of the tiled image");
+#endif
+
+	m_tiles[index].pixels = (uint32_t *) view;
+}
+
+void tiled_image::unmap_tile(const uint32_t index)
+{
+#ifdef _WIN32
+	UnmapViewOfFile(m_tiles[index].pixels);
+#else
+	munmap(m_tiles[index].pixels, (size_t) m_tile_bytes);
+#endif
+	m_tiles[index].pixels = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace sdfgen {
+
+	/**
+	* A 32-bit RGBA image kept in a file instead of memory, for images too large to load as an {@link image}.
+	*
+	* <p> The file holds the image as square tiles of {@link #tile_size} pixels, one after another, row
+	* by row, with no header. Tiles are memory-mapped one at a time as they are accessed, and the least
+	* recently used ones are unmapped whenever more than {@code memory_limit} bytes would be mapped,
+	* which lets the operating system write them back. Pixels are only reached through
+	* {@link #read_region} and {@link #write_region}, so any region can be read or written
+	* regardless of tile boundaries, from any thread.
+	*/
+	class tiled_image {
+	private:
+		struct tile_entry {
+			uint32_t * pixels = nullptr;
+			std::list<uint32_t>::iterator position;
+		};
+
+		std::string m_file;
+		uint32_t m_width;
+		uint32_t m_height;
+		uint32_t m_tile_size;
+		uint32_t m_tiles_x;
+		uint32_t m_tiles_y;
+		uint64_t m_tile_bytes;
+		size_t m_max_resident;
+		std::vector<tile_entry> m_tiles;
+		std::list<uint32_t> m_recent;
+		std::mutex m_mutex;
+#ifdef _WIN32
+		void * m_handle;
+		void * m_mapping;
+#else
+		int m_handle;
+#endif
+
+	public:
+		static constexpr uint32_t default_tile_size = 256;
+		static constexpr size_t default_memory_limit = 256 * 1024 * 1024;
+
+		/**
+		* Opens the tile file, creating it if it does not exist yet and growing it to hold the whole image.
+		* An existing file keeps its pixels, so it must have been written with the same size and tile size.
+		*
+		* @param memory_limit the most bytes of tiles to keep mapped at once, at least one tile is always kept
+		* @throws std::exception if the file cannot be opened or mapped
+		*/
+		tiled_image(const std::string& file, const uint32_t width, const uint32_t height,
+			const uint32_t tile_size = default_tile_size, const size_t memory_limit = default_memory_limit);
+		~tiled_image();
+
+		tiled_image(const tiled_image&) = delete;
+		tiled_image& operator=(const tiled_image&) = delete;
+
+		const std::string& file() const { return m_file; }
+		const uint32_t& width() const { return m_width; }
+		const uint32_t& height() const { return m_height; }
+		const uint32_t& tile_size() const { return m_tile_size; }
+		const uint32_t& tiles_x() const { return m_tiles_x; }
+		const uint32_t& tiles_y() const { return m_tiles_y; }
+
+		/** Returns the number of tiles currently mapped. */
+		size_t resident_tiles();
+
+		/**
+		* Copies the pixels of a rectangle into {@code pixels}, paging in the tiles it covers.
+		*
+		* @param stride the number of pixels between the starts of two rows of {@code pixels}
+		* @throws std::exception if the rectangle is not within the image
+		*/
+		void read_region(const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, uint32_t * pixels, const uint32_t stride);
+
+		/**
+		* Copies {@code pixels} into a rectangle of the image, paging in the tiles it covers.
+		*
+		* @param stride the number of pixels between the starts of two rows of {@code pixels}
+		* @throws std::exception if the rectangle is not within the image
+		*/
+		void write_region(const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, const uint32_t * pixels, const uint32_t stride);
+
+		/** Writes every mapped tile back to the file. */
+		void flush();
+
+	private:
+		/**
+		* Returns the pixels of a tile, mapping it if needed and unmapping the least recently used tile
+		* when over the limit. The caller must hold {@link #m_mutex}, the pointer is valid until the next call.
+		*/
+		uint32_t * tile(const uint32_t tile_x, const uint32_t tile_y);
+
+		void map_tile(const uint32_t index);
+		void unmap_tile(const uint32_t index);
+
+		/** Calls {@code copy(tile_pixels, tile_x, tile_y, x, y, width)} for every row segment of a rectangle within one tile. */
+		template<typename Copy>
+		void for_each_segment(const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, const Copy& copy);
+	};
+
+	typedef std::shared_ptr<tiled_image> tiled_image_ptr;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+#include <stdint.h>
+#include "bitmap.h"
+
+namespace sdfgen {
+
+	/**
+	* The window search of {@code algorithm::brute_force} for a {@code ceil(spread)} known at
+	* compile time, see {@link sdf_generator#generate_brute_force}. With at most 64 pixels on either side of
+	* the center, each row of the window is read with a couple of 64-bit loads and no loops, and the rows
+	* are visited from the center outwards, stopping as soon as no further row can hold anything closer.
+	*
+	* <p> Only windows that lie entirely within the image are searched this way, the generic search
+	* handles the rest. Both find the same squared distance.
+	*
+	* <p> The downscale is not a template parameter: it only places the center, once per output pixel
+	* in {@link sdf_generator#scan_windows}, and never enters the loops over the window.
+	*/
+	template<int32_t Delta>
+	class window_search {
+		static_assert(Delta >= 1 && Delta <= 64, "The window must reach at most 64 pixels from the center");
+
+	public:
+		/** Returns {@code true} if the window around {@code (center_x, center_y)} lies entirely within {@code mask}. */
+		static inline bool contains(const bitmap& mask, const uint32_t center_x, const uint32_t center_y)
+		{
+			return center_x >= (uint32_t) Delta && center_y >= (uint32_t) Delta && center_x + Delta < mask.width() && center_y + Delta < mask.height();
+		}
+
+		/**
+		* Returns the squared distance from the center to the closest pixel within the window whose value
+		* differs from {@code base}, or {@code Delta} squared if there is none.
+		*/
+		static inline int32_t find_square_distance(const bitmap& mask, const uint32_t center_x, const uint32_t center_y, const bool base)
+		{
+			const uint64_t flip = base ? ~0ULL : 0ULL;
+			const uint32_t stride = mask.stride();
+			int32_t closest = Delta * Delta;
+
+			const int32_t center_dx = nearest_in_row(mask.row(center_y), stride, center_x, flip);
+			if(center_dx >= 0) closest = center_dx * center_dx;
+
+			for(int32_t dy = 1; dy <= Delta && dy * dy < closest; ++dy) {
+				const int32_t above = nearest_in_row(mask.row(center_y - dy), stride, center_x, flip);
+				const int32_t below = nearest_in_row(mask.row(center_y + dy), stride, center_x, flip);
+				if(above >= 0 && above * above + dy * dy < closest) closest = above * above + dy * dy;
+				if(below >= 0 && below * below + dy * dy < closest) closest = below * below + dy * dy;
+			}
+
+			return closest;
+		}
+
+	private:
+		/** Returns the 64 pixels of a row starting at {@code x}, the ones past the end of the row as zeros. */
+		static inline uint64_t bits_from(const uint64_t * row, const uint32_t stride, const uint32_t x)
+		{
+			const uint32_t word = x / bitmap::word_bits;
+			const uint32_t bit = x % bitmap::word_bits;
+			uint64_t bits = row[word] >> bit;
+			if(bit && word + 1 < stride) bits |= row[word + 1] << (bitmap::word_bits - bit);
+			return bits;
+		}
+
+		/** Same as {@link bitmap#find_nearest_in_row} over the window, with {@code flip} set when looking for "outside" pixels. */
+		static inline int32_t nearest_in_row(const uint64_t * row, const uint32_t stride, const uint32_t center_x, const uint64_t flip)
+		{
+			// The center and the Delta pixels right of it. A window of 64 needs one more bit than a word holds:
+			constexpr uint64_t right_mask = Delta >= 63 ? ~0ULL : (1ULL << (Delta + 1)) - 1;
+			const uint64_t right = (bits_from(row, stride, center_x) ^ flip) & right_mask;
+			int32_t nearest = -1;
+			if(right) {
+				nearest = (int32_t) bitmap::count_trailing_zeros(right);
+				if(nearest == 0) return 0;
+			}
+			else if(Delta == 64 && ((bits_from(row, stride, center_x + 64) ^ flip) & 1ULL)) {
+				nearest = 64;
+			}
+
+			// The Delta pixels left of the center, where the highest set bit is the closest:
+			constexpr uint64_t left_mask = Delta >= 64 ? ~0ULL : (1ULL << Delta) - 1;
+			const uint64_t left = (bits_from(row, stride, center_x - Delta) ^ flip) & left_mask;
+			if(left) {
+				const int32_t distance = Delta - (int32_t) (bitmap::word_bits - 1 - bitmap::count_leading_zeros(left));
+				if(nearest < 0 || distance < nearest) nearest = distance;
+			}
+
+			return nearest;
+		}
+	};
+
+}
\ No newline at end of file